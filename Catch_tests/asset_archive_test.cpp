@@ -0,0 +1,106 @@
+#include "assets/asset_archive.h"
+#include "assets/asset_archive_format.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace
+{
+void write_file(const std::filesystem::path &path, const std::string &content)
+{
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream stream{path, std::ios::binary};
+    stream << content;
+}
+
+std::string_view as_string(const AssetView &asset)
+{
+    return std::string_view{reinterpret_cast<const char *>( // NOLINT
+                                asset.data),
+                            asset.size};
+}
+} // namespace
+
+TEST_CASE("Packed assets are found by relative path", "[asset_archive]")
+{
+    const std::filesystem::path directory{
+        std::filesystem::temp_directory_path() / "asset_archive_test"};
+    const std::filesystem::path archive_path{
+        std::filesystem::temp_directory_path() / "asset_archive_test.pak"};
+    std::filesystem::remove_all(directory);
+    write_file(directory / "fonts" / "body.ttf", "font bytes");
+    write_file(directory / "empty.bin", "");
+    write_file(directory / "a.txt", "first");
+
+    REQUIRE(pack_asset_archive(directory, archive_path));
+
+    AssetArchive archive{};
+    REQUIRE(archive.open(archive_path));
+    REQUIRE(archive.asset_count() == 3);
+
+    AssetView asset{};
+    REQUIRE(archive.find("fonts/body.ttf", asset));
+    REQUIRE(as_string(asset) == "font bytes");
+    REQUIRE(reinterpret_cast<std::uintptr_t>(asset.data) % // NOLINT
+                asset_archive::kAlignment ==
+            0);
+    REQUIRE(archive.find("a.txt", asset));
+    REQUIRE(as_string(asset) == "first");
+    REQUIRE(archive.find("empty.bin", asset));
+    REQUIRE(asset.size == 0);
+    REQUIRE_FALSE(archive.find("missing.ttf", asset));
+
+    archive.close();
+    std::filesystem::remove_all(directory);
+    std::filesystem::remove(archive_path);
+}
+
+TEST_CASE("Files that are not archives are rejected", "[asset_archive]")
+{
+    const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                     "asset_archive_invalid.pak"};
+    write_file(path, std::string(128, 'x'));
+
+    AssetArchive archive{};
+    REQUIRE_FALSE(archive.open(path));
+    REQUIRE_FALSE(archive.is_open());
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Entries whose range wraps around are rejected", "[asset_archive]")
+{
+    const std::filesystem::path directory{
+        std::filesystem::temp_directory_path() / "asset_archive_wrap_test"};
+    const std::filesystem::path archive_path{
+        std::filesystem::temp_directory_path() / "asset_archive_wrap_test.pak"};
+    std::filesystem::remove_all(directory);
+    write_file(directory / "a.txt", "first");
+    REQUIRE(pack_asset_archive(directory, archive_path));
+
+    // An aligned offset near the top of the range whose end wraps past zero
+    std::fstream stream{archive_path,
+                        std::ios::binary | std::ios::in | std::ios::out};
+    asset_archive::FileHeader header{};
+    stream.read(reinterpret_cast<char *>(&header), // NOLINT
+                sizeof(header));
+    asset_archive::IndexEntry entry{};
+    stream.seekg(static_cast<std::streamoff>(header.index_offset));
+    stream.read(reinterpret_cast<char *>(&entry), sizeof(entry)); // NOLINT
+    entry.offset = UINT64_MAX - asset_archive::kAlignment + 1;
+    entry.size = 2 * asset_archive::kAlignment;
+    stream.seekp(static_cast<std::streamoff>(header.index_offset));
+    stream.write(reinterpret_cast<const char *>(&entry), // NOLINT
+                 sizeof(entry));
+    stream.close();
+
+    AssetArchive archive{};
+    REQUIRE_FALSE(archive.open(archive_path));
+    std::filesystem::remove_all(directory);
+    std::filesystem::remove(archive_path);
+}
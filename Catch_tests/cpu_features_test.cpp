@@ -0,0 +1,62 @@
+#include "platform/cpu_features.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+CpuFeatures avx2_features()
+{
+    CpuFeatures features{};
+    features.sse4_1 = true;
+    features.sse4_2 = true;
+    features.popcnt = true;
+    features.avx = true;
+    features.avx2 = true;
+    features.fma = true;
+    features.f16c = true;
+    features.lzcnt = true;
+    features.bmi1 = true;
+    return features;
+}
+} // namespace
+
+TEST_CASE("A CPU without extensions runs the SSE2 build", "[cpu_features]")
+{
+    REQUIRE(best_isa_level(CpuFeatures{}) == IsaLevel::SSE2);
+}
+
+TEST_CASE("AVX2 needs every extension Jolt enables with it", "[cpu_features]")
+{
+    CpuFeatures features{avx2_features()};
+    REQUIRE(best_isa_level(features) == IsaLevel::AVX2);
+
+    features.lzcnt = false;
+    REQUIRE_FALSE(supports(features, IsaLevel::AVX2));
+    REQUIRE(best_isa_level(features) == IsaLevel::SSE4_2);
+}
+
+TEST_CASE("AVX-512 needs the F, VL and DQ subsets", "[cpu_features]")
+{
+    CpuFeatures features{avx2_features()};
+    features.avx512f = true;
+    features.avx512vl = true;
+    REQUIRE(best_isa_level(features) == IsaLevel::AVX2);
+
+    features.avx512dq = true;
+    REQUIRE(best_isa_level(features) == IsaLevel::AVX512);
+}
+
+TEST_CASE("Level names parse ignoring case", "[cpu_features]")
+{
+    REQUIRE(parse_isa_level("avx512") == IsaLevel::AVX512);
+    REQUIRE(parse_isa_level("SSE4_2") == IsaLevel::SSE4_2);
+    REQUIRE_FALSE(parse_isa_level("AVX").has_value());
+    REQUIRE(isa_suffix(IsaLevel::SSE4_2) == "sse4_2");
+}
+
+TEST_CASE("The detected level is supported by the detected features",
+          "[cpu_features]")
+{
+    const CpuFeatures features{read_cpu_features()};
+    REQUIRE(supports(features, best_isa_level(features)));
+}
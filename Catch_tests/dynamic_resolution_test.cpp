@@ -0,0 +1,65 @@
+#include "game/dynamic_resolution.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+
+namespace
+{
+constexpr float kBudget{1.F / 60.F};
+constexpr float kSlowFrame{kBudget * 1.5F};
+
+void add_frames(DynamicResolution &controller,
+                const std::size_t count,
+                const float frame_time)
+{
+    for (std::size_t frame{0}; frame < count; ++frame)
+    {
+        controller.add_frame_time(frame_time);
+    }
+}
+} // namespace
+
+TEST_CASE("Dynamic resolution drops a level when a window runs over budget",
+          "[dynamic_resolution]")
+{
+    DynamicResolution controller{kBudget};
+    add_frames(controller, DynamicResolution::kWindowSize - 1, kSlowFrame);
+    REQUIRE(controller.level() == 0);
+
+    add_frames(controller, 1, kSlowFrame);
+    REQUIRE(controller.level() == 1);
+    REQUIRE(controller.scale() < 1.F);
+}
+
+TEST_CASE("Dynamic resolution stops at the lowest level",
+          "[dynamic_resolution]")
+{
+    DynamicResolution controller{kBudget};
+    add_frames(controller,
+               DynamicResolution::kWindowSize * (kResolutionScales.size() + 2),
+               kSlowFrame);
+    REQUIRE(controller.level() == kResolutionScales.size() - 1);
+}
+
+TEST_CASE("Dynamic resolution backs off after a failed climb",
+          "[dynamic_resolution]")
+{
+    DynamicResolution controller{kBudget};
+    add_frames(controller, DynamicResolution::kWindowSize, kSlowFrame);
+    REQUIRE(controller.level() == 1);
+
+    // Within budget at the lower level, so it climbs back after one window
+    add_frames(controller, DynamicResolution::kWindowSize, kBudget);
+    REQUIRE(controller.level() == 0);
+
+    // Full resolution is immediately too slow
+    add_frames(controller, DynamicResolution::kWindowSize, kSlowFrame);
+    REQUIRE(controller.level() == 1);
+
+    // The next climb now needs two windows within budget
+    add_frames(controller, DynamicResolution::kWindowSize, kBudget);
+    REQUIRE(controller.level() == 1);
+    add_frames(controller, DynamicResolution::kWindowSize, kBudget);
+    REQUIRE(controller.level() == 0);
+}
@@ -0,0 +1,56 @@
+#include "platform/file_watcher.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace
+{
+// Polls until the watcher reports the file, allowing for the fallback's poll
+// interval and coarse file times
+bool wait_for_change(FileWatcher &watcher, const std::size_t handle)
+{
+    const auto deadline{std::chrono::steady_clock::now() +
+                        std::chrono::seconds{3}};
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        watcher.poll();
+        if (watcher.take_changed(handle))
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    return false;
+}
+} // namespace
+
+TEST_CASE("Writing a watched file is reported once", "[file_watcher]")
+{
+    const std::filesystem::path directory{
+        std::filesystem::temp_directory_path() / "file_watcher_test"};
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path watched{directory / "watched.cfg"};
+    const std::filesystem::path other{directory / "other.cfg"};
+    std::ofstream{watched} << "first";
+
+    FileWatcher watcher{};
+    const std::size_t handle{watcher.watch(watched)};
+    watcher.poll();
+    REQUIRE_FALSE(watcher.take_changed(handle));
+
+    std::ofstream{other} << "not watched";
+    // Coarse file times need the rewrite to land in a later tick
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    std::ofstream{watched} << "second";
+    REQUIRE(wait_for_change(watcher, handle));
+    watcher.poll();
+    REQUIRE_FALSE(watcher.take_changed(handle));
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,59 @@
+#include "physics/flight_recorder.h"
+#include "physics/flight_recorder_format.h"
+#include "headless/headless_loop.h"
+#include "platform/mapped_file.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+
+TEST_CASE("Flight recorder keeps the newest records in its ring",
+          "[flight_recorder]")
+{
+    constexpr std::size_t kCapacity{16};
+    constexpr int kSteps{40};
+    const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                     "flight_recorder_test.bin"};
+
+    HeadlessLoop loop{};
+    FlightRecorder recorder{};
+    REQUIRE(recorder.open(path, kCapacity));
+    for (int step{0}; step < kSteps; ++step)
+    {
+        loop.step();
+        recorder.record_step(loop.physics_engine());
+    }
+    recorder.close();
+
+    MappedFile file{};
+    REQUIRE(file.open_read_only(path));
+    flight_recorder::FileHeader header{};
+    std::memcpy(&header, file.data(), sizeof(header));
+    REQUIRE(header.magic == flight_recorder::kMagic);
+    REQUIRE(header.capacity == kCapacity);
+    // Only the ball is awake, one record a step
+    REQUIRE(header.write_index == kSteps);
+    REQUIRE(header.last_step == loop.physics_engine().get_step());
+
+    flight_recorder::BodyRecord newest{};
+    std::memcpy(&newest,
+                file.data() + flight_recorder::kHeaderSize +
+                    ((header.write_index - 1) % kCapacity) * sizeof(newest),
+                sizeof(newest));
+    REQUIRE(newest.step == header.last_step);
+    REQUIRE(newest.active == 1);
+
+    file.close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Flight recorder refuses a ring with no room", "[flight_recorder]")
+{
+    const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                     "flight_recorder_empty_test.bin"};
+    FlightRecorder recorder{};
+    REQUIRE_FALSE(recorder.open(path, 0));
+    REQUIRE_FALSE(recorder.recording());
+}
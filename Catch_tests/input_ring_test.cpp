@@ -0,0 +1,49 @@
+#include "game/input_ring.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+
+TEST_CASE("Input ring returns events in order", "[input_ring]")
+{
+    SpscRing<int, 4> ring{};
+    REQUIRE(ring.push(1));
+    REQUIRE(ring.push(2));
+
+    int value{0};
+    REQUIRE(ring.pop(value));
+    REQUIRE(value == 1);
+    REQUIRE(ring.pop(value));
+    REQUIRE(value == 2);
+    REQUIRE_FALSE(ring.pop(value));
+}
+
+TEST_CASE("Input ring counts overflow instead of overwriting",
+          "[input_ring]")
+{
+    SpscRing<int, 4> ring{};
+    for (int index{0}; index < 6; ++index)
+    {
+        ring.push(index);
+    }
+    REQUIRE(ring.size() == 4);
+    REQUIRE(ring.overflow_count() == 2);
+
+    int value{-1};
+    REQUIRE(ring.pop(value));
+    REQUIRE(value == 0);
+}
+
+TEST_CASE("Input ring wraps around", "[input_ring]")
+{
+    SpscRing<int, 4> ring{};
+    int value{0};
+    for (int index{0}; index < 10; ++index)
+    {
+        REQUIRE(ring.push(index));
+        REQUIRE(ring.pop(value));
+        REQUIRE(value == index);
+    }
+    REQUIRE(ring.size() == 0);
+    REQUIRE(ring.overflow_count() == 0);
+}
@@ -0,0 +1,61 @@
+#include "game/latency_tracker.h"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+
+namespace
+{
+using Clock = LatencyTracker::Clock;
+using std::chrono::milliseconds;
+} // namespace
+
+TEST_CASE("Latency is measured from input to the next present",
+          "[latency_tracker]")
+{
+    LatencyTracker tracker{};
+    const Clock::time_point input{Clock::now()};
+    tracker.begin(input, input + milliseconds{4}, false);
+    tracker.mark_present(input + milliseconds{20});
+
+    const LatencySummary summary{tracker.summary()};
+    REQUIRE(summary.samples == 1);
+    REQUIRE(summary.p50_milliseconds == Catch::Approx(20.F));
+    REQUIRE(summary.max_milliseconds == Catch::Approx(20.F));
+    REQUIRE(summary.mean_tick_wait_milliseconds == Catch::Approx(4.F));
+}
+
+TEST_CASE("Physics driven input waits for a physics step",
+          "[latency_tracker]")
+{
+    LatencyTracker tracker{};
+    const Clock::time_point input{Clock::now()};
+    tracker.begin(input, input, true);
+
+    tracker.mark_present(input + milliseconds{10});
+    REQUIRE(tracker.summary().samples == 0);
+
+    tracker.mark_physics_step();
+    tracker.mark_present(input + milliseconds{30});
+    const LatencySummary summary{tracker.summary()};
+    REQUIRE(summary.samples == 1);
+    REQUIRE(summary.p50_milliseconds == Catch::Approx(30.F));
+}
+
+TEST_CASE("Latency percentiles", "[latency_tracker]")
+{
+    LatencyTracker tracker{};
+    const Clock::time_point input{Clock::now()};
+    for (int sample{1}; sample <= 100; ++sample)
+    {
+        tracker.begin(input, input, false);
+        tracker.mark_present(input + milliseconds{sample});
+    }
+
+    const LatencySummary summary{tracker.summary()};
+    REQUIRE(summary.samples == 100);
+    REQUIRE(summary.p50_milliseconds == Catch::Approx(51.F));
+    REQUIRE(summary.p99_milliseconds == Catch::Approx(100.F));
+    REQUIRE(summary.max_milliseconds == Catch::Approx(100.F));
+}
@@ -0,0 +1,255 @@
+#include "headless/benchmark_scene.h"
+#include "physics/physics.h"
+#include "physics/vec3.h"
+#include "scene/scene.h"
+#include "scene/scene_loader.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/StateRecorderImpl.h>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Built as a separate executable so the unit test run stays fast. The
+// run_benchmarks target runs them and writes XML results for tracking across
+// commits.
+
+namespace
+{
+constexpr float kStep{1.F / 60.F};
+// Two seconds: long enough for the dropped balls to land and pile up, so a
+// step has contacts to solve
+constexpr int kSettleSteps{120};
+
+// A built world, cleaned up on scope exit so a failed REQUIRE does not leak
+// Jolt's global factory into the next case
+class BenchmarkWorld
+{
+public:
+    // spare_bodies leaves room to add bodies after the scene is built
+    explicit BenchmarkWorld(const std::size_t body_count,
+                            const std::size_t spare_bodies = 0)
+    {
+        _physics_engine.initialise(
+            benchmark_scene::physics_config(body_count + spare_bodies));
+        benchmark_scene::build(_physics_engine,
+                               body_count,
+                               benchmark_scene::kDefaultSeed,
+                               _body_ids);
+    }
+    BenchmarkWorld(const BenchmarkWorld &) = delete;
+    BenchmarkWorld &operator=(const BenchmarkWorld &) = delete;
+    BenchmarkWorld(BenchmarkWorld &&) = delete;
+    BenchmarkWorld &operator=(BenchmarkWorld &&) = delete;
+    ~BenchmarkWorld()
+    {
+        _physics_engine.cleanup();
+    }
+
+    PhysicsEngine &physics_engine()
+    {
+        return _physics_engine;
+    }
+
+private:
+    PhysicsEngine _physics_engine{};
+    std::vector<JPH::BodyID> _body_ids{};
+};
+
+// A level floor laid out as a grid of 1 m static boxes, loaded through the
+// scene loader so the boxes can be merged
+class BoxLevel
+{
+public:
+    static constexpr uint32_t kSide{100};
+
+    explicit BoxLevel(const float merge_cell)
+    {
+        SceneWorld world{};
+        world.max_bodies = kSide * kSide;
+        world.merge_cell = merge_cell;
+        _scene_loader.begin(world);
+
+        std::vector<SceneBody> boxes{};
+        boxes.reserve(world.max_bodies);
+        for (uint32_t row{0}; row < kSide; ++row)
+        {
+            for (uint32_t column{0}; column < kSide; ++column)
+            {
+                SceneBody &box{boxes.emplace_back()};
+                box.shape = SceneShape::Box;
+                box.motion = SceneMotion::Static;
+                box.position = Vec3{static_cast<float>(column) + 0.5F,
+                                    0.F,
+                                    static_cast<float>(row) + 0.5F};
+            }
+        }
+        _scene_loader.add_bodies(boxes);
+        _scene_loader.end();
+        _physics_engine.start_simulation();
+    }
+    BoxLevel(const BoxLevel &) = delete;
+    BoxLevel &operator=(const BoxLevel &) = delete;
+    BoxLevel(BoxLevel &&) = delete;
+    BoxLevel &operator=(BoxLevel &&) = delete;
+    ~BoxLevel()
+    {
+        _physics_engine.cleanup();
+    }
+
+    PhysicsEngine &physics_engine()
+    {
+        return _physics_engine;
+    }
+
+    [[nodiscard]] std::size_t body_count() const
+    {
+        return _scene_loader.world_body_count();
+    }
+
+private:
+    PhysicsEngine _physics_engine{};
+    SceneLoader _scene_loader{_physics_engine};
+};
+} // namespace
+
+TEST_CASE("World creation", "[benchmark][physics]")
+{
+    const std::size_t body_count{GENERATE(1'000U, 10'000U)};
+    BENCHMARK("Create and destroy " + std::to_string(body_count) + " bodies")
+    {
+        const BenchmarkWorld world{body_count};
+    };
+}
+
+TEST_CASE("Physics step", "[benchmark][physics]")
+{
+    const std::size_t body_count{GENERATE(1'000U, 10'000U, 50'000U)};
+    BenchmarkWorld world{body_count};
+    world.physics_engine().start_simulation();
+    for (int step{0}; step < kSettleSteps; ++step)
+    {
+        world.physics_engine().step(kStep);
+    }
+
+    // Stepping the same world over and over would let the balls settle and
+    // sleep, so the figure would depend on how many runs Catch picks. Every
+    // sample restores the landed world, untimed, and times the step after it.
+    // A step this long is run once per sample.
+    JPH::StateRecorderImpl snapshot{};
+    world.physics_engine().save_state(snapshot);
+    BENCHMARK_ADVANCED("Step " + std::to_string(body_count) + " bodies")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        snapshot.Rewind();
+        REQUIRE(world.physics_engine().restore_state(snapshot));
+        meter.measure([&] { world.physics_engine().step(kStep); });
+    };
+}
+
+TEST_CASE("Broad phase optimisation", "[benchmark][physics]")
+{
+    const std::size_t body_count{GENERATE(1'000U, 10'000U, 50'000U)};
+    BenchmarkWorld world{body_count};
+
+    BENCHMARK("Optimise " + std::to_string(body_count) + " bodies")
+    {
+        world.physics_engine().start_simulation();
+    };
+}
+
+TEST_CASE("Snapshot save and restore", "[benchmark][physics]")
+{
+    const std::size_t body_count{GENERATE(1'000U, 10'000U)};
+    BenchmarkWorld world{body_count};
+    world.physics_engine().start_simulation();
+
+    BENCHMARK("Save " + std::to_string(body_count) + " bodies")
+    {
+        JPH::StateRecorderImpl recorder{};
+        world.physics_engine().save_state(recorder);
+    };
+
+    JPH::StateRecorderImpl snapshot{};
+    world.physics_engine().save_state(snapshot);
+    BENCHMARK_ADVANCED("Restore " + std::to_string(body_count) + " bodies")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure(
+            [&]
+            {
+                snapshot.Rewind();
+                return world.physics_engine().restore_state(snapshot);
+            });
+    };
+    snapshot.Rewind();
+    REQUIRE(world.physics_engine().restore_state(snapshot));
+}
+
+TEST_CASE("Body add and remove churn", "[benchmark][physics]")
+{
+    constexpr std::size_t kBaseBodies{1'000};
+    constexpr std::size_t kChurnBodies{100};
+    BenchmarkWorld world{kBaseBodies, kChurnBodies};
+    world.physics_engine().start_simulation();
+
+    std::vector<JPH::BodyID> churn_ids{};
+    churn_ids.reserve(kChurnBodies);
+    world.physics_engine().step(kStep);
+    BENCHMARK("Add and remove " + std::to_string(kChurnBodies) + " bodies")
+    {
+        for (std::size_t index{0}; index < kChurnBodies; ++index)
+        {
+            churn_ids.push_back(world.physics_engine().add_ball(
+                0.5F,
+                Vec3{static_cast<float>(index), 20.F, 0.F},
+                Vec3{0.F, 0.F, 0.F}));
+        }
+        for (const JPH::BodyID &body_id : churn_ids)
+        {
+            world.physics_engine().destroy_body(body_id);
+        }
+        churn_ids.clear();
+    };
+}
+
+TEST_CASE("Static merging broad phase queries", "[benchmark][physics]")
+{
+    // Unmerged, every box is a leaf of the static tree. Merged into 8 m
+    // cells, the tree only holds one body per cell.
+    const float merge_cell{GENERATE(0.F, 8.F)};
+    BoxLevel level{merge_cell};
+    constexpr std::size_t kQueries{1'000};
+    constexpr float kQueryHalfSize{1.F};
+    constexpr uint32_t kStride{37};
+
+    JPH::BodyIDVector hits{};
+    hits.reserve(BoxLevel::kSide * BoxLevel::kSide);
+    BENCHMARK(std::to_string(kQueries) + " box queries over " +
+              std::to_string(BoxLevel::kSide * BoxLevel::kSide) +
+              " boxes as " + std::to_string(level.body_count()) + " bodies")
+    {
+        // Query centres walk the level in a fixed, scattered order
+        std::size_t hit_count{0};
+        for (std::size_t query{0}; query < kQueries; ++query)
+        {
+            const auto step{static_cast<uint32_t>(query) * kStride};
+            const auto x{static_cast<float>(step % BoxLevel::kSide)};
+            const auto z{static_cast<float>(step / BoxLevel::kSide %
+                                            BoxLevel::kSide)};
+            level.physics_engine().get_bodies_in_box(
+                Vec3{x - kQueryHalfSize, -kQueryHalfSize, z - kQueryHalfSize},
+                Vec3{x + kQueryHalfSize, kQueryHalfSize, z + kQueryHalfSize},
+                hits);
+            hit_count += hits.size();
+        }
+        return hit_count;
+    };
+}
@@ -0,0 +1,157 @@
+#include "headless/benchmark_scene.h"
+#include "physics/physics.h"
+#include "physics/vec3.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Physics/Body/BodyID.h>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+constexpr float kStep{1.F / 60.F};
+
+void build_scene(PhysicsEngine &physics_engine, Vec3 &sphere_position)
+{
+    physics_engine.initialise();
+    physics_engine.create_floor(Vec3{5.F, 1.F, 5.F}, Vec3{0.F, -1.F, 0.F});
+    physics_engine.create_ball(0.5F, sphere_position, Vec3{0.F, 0.F, 0.F});
+    physics_engine.start_simulation();
+}
+} // namespace
+
+TEST_CASE("A dropped ball falls under gravity", "[physics]")
+{
+    PhysicsEngine physics_engine{};
+    Vec3 sphere_position{0.F, 10.F, 0.F};
+    build_scene(physics_engine, sphere_position);
+    REQUIRE(physics_engine.get_num_bodies() == 2);
+
+    for (int step{0}; step < 30; ++step)
+    {
+        REQUIRE(physics_engine.update(kStep, sphere_position));
+    }
+    REQUIRE(sphere_position.y < 10.F);
+    REQUIRE(sphere_position.y > 0.F);
+
+    physics_engine.cleanup();
+}
+
+TEST_CASE("An upward kick makes the ball rise", "[physics]")
+{
+    PhysicsEngine physics_engine{};
+    Vec3 sphere_position{0.F, 5.F, 0.F};
+    build_scene(physics_engine, sphere_position);
+
+    physics_engine.add_ball_velocity(Vec3{0.F, 5.F, 0.F});
+    for (int step{0}; step < 10; ++step)
+    {
+        physics_engine.update(kStep, sphere_position);
+    }
+    REQUIRE(sphere_position.y > 5.F);
+
+    physics_engine.cleanup();
+}
+
+TEST_CASE("An explosion wakes a sleeping ball and pushes it away",
+          "[physics]")
+{
+    PhysicsEngine physics_engine{};
+    Vec3 sphere_position{0.F, 0.5F, 0.F};
+    build_scene(physics_engine, sphere_position);
+
+    bool asleep{false};
+    for (int step{0}; step < 600 && !asleep; ++step)
+    {
+        asleep = !physics_engine.update(kStep, sphere_position);
+    }
+    REQUIRE(asleep);
+
+    physics_engine.apply_radial_impulse(Vec3{-1.F, 0.5F, 0.F}, 2.F, 2'000.F);
+    for (int step{0}; step < 10; ++step)
+    {
+        REQUIRE(physics_engine.update(kStep, sphere_position));
+    }
+    REQUIRE(sphere_position.x > 0.1F);
+
+    physics_engine.cleanup();
+}
+
+TEST_CASE("Explosions queued together only push bodies in their radius",
+          "[physics]")
+{
+    PhysicsEngine physics_engine{};
+    Vec3 sphere_position{0.F, 5.F, 0.F};
+    build_scene(physics_engine, sphere_position);
+    const JPH::BodyID left{physics_engine.add_ball(
+        0.3F, Vec3{-3.F, 0.3F, 0.F}, Vec3{0.F, 0.F, 0.F})};
+    const JPH::BodyID right{physics_engine.add_ball(
+        0.3F, Vec3{3.F, 0.3F, 0.F}, Vec3{0.F, 0.F, 0.F})};
+    const JPH::BodyID distant{physics_engine.add_ball(
+        0.3F, Vec3{0.F, 0.3F, 4.F}, Vec3{0.F, 0.F, 0.F})};
+
+    physics_engine.apply_radial_impulse(
+        Vec3{-2.5F, 0.3F, 0.F}, 2.F, 500.F, 2.F);
+    physics_engine.apply_radial_impulse(Vec3{2.5F, 0.3F, 0.F}, 2.F, 500.F);
+    for (int step{0}; step < 10; ++step)
+    {
+        physics_engine.update(kStep, sphere_position);
+    }
+
+    Vec3 position{};
+    REQUIRE(physics_engine.get_body_position(left, position));
+    REQUIRE(position.x < -3.05F);
+    REQUIRE(physics_engine.get_body_position(right, position));
+    REQUIRE(position.x > 3.05F);
+    REQUIRE(physics_engine.get_body_position(distant, position));
+    REQUIRE(position.x > -0.01F);
+    REQUIRE(position.x < 0.01F);
+    REQUIRE(position.z > 3.99F);
+    REQUIRE(position.z < 4.01F);
+
+    physics_engine.cleanup();
+}
+
+TEST_CASE("The benchmark scene is the same for the same seed", "[physics]")
+{
+    constexpr std::size_t kBodies{64};
+
+    // Engines share Jolt's global factory, so build one scene at a time
+    const auto build_states{[]()
+                            {
+                                PhysicsEngine physics_engine{};
+                                physics_engine.initialise(
+                                    benchmark_scene::physics_config(kBodies));
+                                std::vector<JPH::BodyID> body_ids{};
+                                benchmark_scene::build(
+                                    physics_engine,
+                                    kBodies,
+                                    benchmark_scene::kDefaultSeed,
+                                    body_ids);
+
+                                std::vector<BodyState> states{};
+                                for (const JPH::BodyID &body_id : body_ids)
+                                {
+                                    BodyState state{};
+                                    REQUIRE(physics_engine.get_body_state(
+                                        body_id, state));
+                                    states.push_back(state);
+                                }
+                                physics_engine.cleanup();
+                                return states;
+                            }};
+
+    const std::vector<BodyState> first{build_states()};
+    const std::vector<BodyState> second{build_states()};
+    REQUIRE(first.size() == kBodies);
+    REQUIRE(second.size() == kBodies);
+    for (std::size_t index{0}; index < kBodies; ++index)
+    {
+        REQUIRE(first[index].position == second[index].position);
+        REQUIRE(first[index].linear_velocity ==
+                second[index].linear_velocity);
+    }
+}
@@ -0,0 +1,432 @@
+#include "physics/physics.h"
+#include "scene/destructible_system.h"
+#include "scene/scene.h"
+#include "scene/scene_diff.h"
+#include "scene/scene_loader.h"
+#include "scene/scene_parser.h"
+#include "scene/spawner_system.h"
+#include "scene/static_merge.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Keeps everything it is given, and the size of each batch
+class RecordingSink final : public SceneSink
+{
+public:
+    void begin(const SceneWorld &world) override
+    {
+        ++begin_calls;
+        this->world = world;
+    }
+
+    void add_bodies(const std::vector<SceneBody> &batch) override
+    {
+        batch_sizes.push_back(batch.size());
+        bodies.insert(bodies.end(), batch.begin(), batch.end());
+    }
+
+    void add_spawner(const SceneSpawner &spawner) override
+    {
+        spawners.push_back(spawner);
+    }
+
+    void add_destructible(const SceneDestructible &destructible) override
+    {
+        destructibles.push_back(destructible);
+    }
+
+    void end() override
+    {
+        ++end_calls;
+    }
+
+    int begin_calls{0};
+    int end_calls{0};
+    SceneWorld world{};
+    std::vector<SceneBody> bodies{};
+    std::vector<std::size_t> batch_sizes{};
+    std::vector<SceneSpawner> spawners{};
+    std::vector<SceneDestructible> destructibles{};
+};
+
+bool parse(const std::string &text, SceneSink &sink, std::size_t batch_size = 4)
+{
+    std::istringstream stream{text};
+    return scene_parser::parse(stream, "test.scene", sink, batch_size);
+}
+} // namespace
+
+TEST_CASE("Scene lines become bodies, materials and spawners", "[scene]")
+{
+    RecordingSink sink{};
+    REQUIRE(parse("# A comment line\n"
+                  "world bodies 64 pairs 100\n"
+                  "\n"
+                  "material bouncy friction 0.5 restitution 0.8\n"
+                  "box static position 0 -1 0 half_extents 5 1 5\n"
+                  "sphere dynamic position 1 2 3 radius 0.25 velocity 1 0 0 "
+                  "material bouncy ball # the ball\n"
+                  "spawner position 0 5 0 velocity 0 -1 0 rate 10 limit 20\n",
+                  sink));
+
+    REQUIRE(sink.begin_calls == 1);
+    REQUIRE(sink.end_calls == 1);
+    REQUIRE(sink.world.max_bodies == 64);
+    REQUIRE(sink.world.max_body_pairs == 100);
+    REQUIRE(sink.world.max_contact_constraints == 0);
+    REQUIRE(sink.world.merge_cell == 0.F);
+
+    REQUIRE(sink.bodies.size() == 2);
+    const SceneBody &floor{sink.bodies[0]};
+    REQUIRE(floor.shape == SceneShape::Box);
+    REQUIRE(floor.motion == SceneMotion::Static);
+    REQUIRE(floor.position.y == -1.F);
+    REQUIRE(floor.half_extents.x == 5.F);
+    REQUIRE_FALSE(floor.ball);
+
+    const SceneBody &ball{sink.bodies[1]};
+    REQUIRE(ball.shape == SceneShape::Sphere);
+    REQUIRE(ball.motion == SceneMotion::Dynamic);
+    REQUIRE(ball.position.z == 3.F);
+    REQUIRE(ball.radius == 0.25F);
+    REQUIRE(ball.velocity.x == 1.F);
+    REQUIRE(ball.material.friction == 0.5F);
+    REQUIRE(ball.material.restitution == 0.8F);
+    REQUIRE(ball.ball);
+
+    REQUIRE(sink.spawners.size() == 1);
+    REQUIRE(sink.spawners.front().rate == 10.F);
+    REQUIRE(sink.spawners.front().limit == 20);
+}
+
+TEST_CASE("Destructible lines describe blocks of parts", "[scene]")
+{
+    RecordingSink sink{};
+    REQUIRE(parse("material stone friction 0.6\n"
+                  "destructible static position 0 2 5 parts 4 3 1 "
+                  "part_radius 0.5 threshold 200 detach material stone\n"
+                  "destructible dynamic position 0 8 0\n",
+                  sink));
+
+    REQUIRE(sink.destructibles.size() == 2);
+    const SceneDestructible &wall{sink.destructibles[0]};
+    REQUIRE(wall.motion == SceneMotion::Static);
+    REQUIRE(wall.position.z == 5.F);
+    REQUIRE(wall.parts_x == 4);
+    REQUIRE(wall.parts_y == 3);
+    REQUIRE(wall.parts_z == 1);
+    REQUIRE(wall.part_radius == 0.5F);
+    REQUIRE(wall.threshold == 200.F);
+    REQUIRE(wall.detach);
+    REQUIRE(wall.material.friction == 0.6F);
+
+    const SceneDestructible &block{sink.destructibles[1]};
+    REQUIRE(block.motion == SceneMotion::Dynamic);
+    REQUIRE(block.parts_x == 1);
+    REQUIRE_FALSE(block.detach);
+}
+
+TEST_CASE("Scene bodies arrive in batches", "[scene]")
+{
+    std::string text{};
+    for (int body{0}; body < 10; ++body)
+    {
+        text += "sphere dynamic position 0 " + std::to_string(body) +
+                " 0 radius 0.5\n";
+    }
+
+    RecordingSink sink{};
+    REQUIRE(parse(text, sink, 4));
+    REQUIRE(sink.begin_calls == 1);
+    REQUIRE(sink.world.max_bodies == SceneWorld{}.max_bodies);
+    const std::vector<std::size_t> expected_batch_sizes{4, 4, 2};
+    REQUIRE(sink.batch_sizes == expected_batch_sizes);
+    REQUIRE(sink.bodies.size() == 10);
+    REQUIRE(sink.bodies.back().position.y == 9.F);
+}
+
+TEST_CASE("An empty scene still begins the world", "[scene]")
+{
+    RecordingSink sink{};
+    REQUIRE(parse("# Nothing here\n", sink));
+    REQUIRE(sink.begin_calls == 1);
+    REQUIRE(sink.end_calls == 1);
+    REQUIRE(sink.batch_sizes.empty());
+}
+
+TEST_CASE("Malformed scene lines are rejected", "[scene]")
+{
+    const std::vector<std::string> bad_scenes{
+        "cube static position 0 0 0\n",
+        "box static position 0 0 0\n",
+        "box sleeping position 0 0 0 half_extents 1 1 1\n",
+        "sphere dynamic position 0 0 radius 1\n",
+        "sphere dynamic position 0 0 0 radius -1\n",
+        "sphere dynamic position 0 0 0 radius 1 material missing\n",
+        "sphere dynamic position 0 0 0 radius 1x\n",
+        "sphere dynamic position 0 0 0 radius 1\nworld bodies 10\n",
+        "world bodies 1.5\n",
+        "world merge_cell -1\n",
+        "spawner velocity 0 0 0\n",
+        "spawner position 0 0 0 lifetime -1\n",
+        "destructible position 0 0 0\n",
+        "destructible static parts 2 2 2\n",
+        "destructible static position 0 0 0 parts 2 0 2\n",
+        "destructible static position 0 0 0 threshold 0\n"};
+    for (const std::string &text : bad_scenes)
+    {
+        RecordingSink sink{};
+        INFO(text);
+        REQUIRE_FALSE(parse(text, sink));
+    }
+}
+
+TEST_CASE("Static bodies cluster by cell and material", "[scene]")
+{
+    RecordingSink sink{};
+    REQUIRE(parse("material ice friction 0\n"
+                  "box static position 0.5 0 0.5 half_extents 0.5 0.5 0.5\n"
+                  "box static position 9 0 1 half_extents 0.5 0.5 0.5\n"
+                  "box static position 1.5 0 0.5 half_extents 0.5 0.5 0.5\n"
+                  "box static position 2.5 0 0.5 half_extents 0.5 0.5 0.5 "
+                  "material ice\n"
+                  "box static position -0.5 0 0.5 half_extents 0.5 0.5 0.5\n"
+                  "box static position 3.5 0 0.5 half_extents 0.5 0.5 0.5\n",
+                  sink));
+
+    StaticClusters clusters{};
+    static_merge::cluster(sink.bodies, 4.F, clusters);
+
+    // x = -0.5 is in the cell below zero, and the ice box is in a cluster of
+    // its own even though it shares a cell
+    REQUIRE(clusters.clusters.size() == 4);
+    const std::vector<std::size_t> expected_members{4, 3, 0, 2, 5, 1};
+    REQUIRE(clusters.members == expected_members);
+    REQUIRE(clusters.clusters[1].count == 1);
+    REQUIRE(clusters.clusters[2].first == 2);
+    REQUIRE(clusters.clusters[2].count == 3);
+
+    static_merge::cluster(sink.bodies, 100.F, clusters);
+    REQUIRE(clusters.clusters.size() == 3);
+}
+
+TEST_CASE("A scene diff keeps unchanged bodies", "[scene]")
+{
+    SceneKeyCollector current{};
+    REQUIRE(parse("box static position 0 -1 0 half_extents 5 1 5\n"
+                  "sphere dynamic position 0 4 0 radius 0.5\n"
+                  "sphere dynamic position 0 4 0 radius 0.5\n"
+                  "sphere dynamic position 2 4 0 radius 0.5\n",
+                  current));
+    SceneKeyCollector next{};
+    REQUIRE(parse("sphere dynamic position 3 4 0 radius 0.5\n"
+                  "box static position 0 -1 0 half_extents 5 1 5\n"
+                  "sphere dynamic position 0 4 0 radius 0.5\n",
+                  next));
+
+    SceneDiff diff{};
+    diff_scene(current.keys(), next.keys(), diff);
+    REQUIRE(diff.kept.size() == 2);
+    const std::vector<std::size_t> expected_removed{2, 3};
+    const std::vector<std::size_t> expected_added{0};
+    REQUIRE(diff.removed == expected_removed);
+    REQUIRE(diff.added == expected_added);
+
+    diff_scene(next.keys(), next.keys(), diff);
+    REQUIRE(diff.kept.size() == 3);
+    REQUIRE(diff.removed.empty());
+    REQUIRE(diff.added.empty());
+}
+
+TEST_CASE("A loaded scene is built in the physics engine", "[scene]")
+{
+    PhysicsEngine physics_engine{};
+    SceneLoader scene_loader{physics_engine};
+    REQUIRE(parse("world bodies 16\n"
+                  "box static position 0 -1 0 half_extents 5 1 5\n"
+                  "sphere dynamic position 0 4 0 radius 0.5 ball\n"
+                  "sphere dynamic position 2 4 0 radius 0.5\n"
+                  "sphere dynamic position 4 4 0 radius 0.25\n",
+                  scene_loader,
+                  2));
+    physics_engine.start_simulation();
+
+    REQUIRE(physics_engine.get_num_bodies() == 4);
+    REQUIRE(scene_loader.body_count() == 4);
+    REQUIRE(scene_loader.spheres().size() == 3);
+    REQUIRE(scene_loader.spheres().back().radius == 0.25F);
+    REQUIRE(scene_loader.ball() == scene_loader.spheres().front().id);
+
+    Vec3 sphere_position{0.F, 4.F, 0.F};
+    for (int step{0}; step < 10; ++step)
+    {
+        REQUIRE(physics_engine.update(1.F / 60.F, sphere_position));
+    }
+    REQUIRE(sphere_position.y < 4.F);
+
+    physics_engine.cleanup();
+}
+
+TEST_CASE("A reloaded scene only changes what differs", "[scene]")
+{
+    PhysicsEngine physics_engine{};
+    SceneLoader scene_loader{physics_engine};
+    REQUIRE(parse("box static position 0 -1 0 half_extents 5 1 5\n"
+                  "sphere dynamic position 0 4 0 radius 0.5 ball\n"
+                  "sphere dynamic position 2 4 0 radius 0.5\n",
+                  scene_loader));
+    physics_engine.start_simulation();
+    const JPH::BodyID ball{scene_loader.ball()};
+
+    const std::string reloaded{
+        "box static position 0 -1 0 half_extents 5 1 5\n"
+        "sphere dynamic position 0 4 0 radius 0.5 ball\n"
+        "sphere dynamic position 4 4 0 radius 0.25\n"
+        "sphere dynamic position 6 4 0 radius 0.25\n"};
+    REQUIRE(scene_loader.reload([&reloaded](SceneSink &sink)
+                                { return parse(reloaded, sink); }));
+
+    REQUIRE(physics_engine.get_num_bodies() == 4);
+    REQUIRE(scene_loader.body_count() == 4);
+    REQUIRE(scene_loader.ball() == ball);
+    REQUIRE(scene_loader.spheres().size() == 3);
+    REQUIRE(scene_loader.spheres().front().id == ball);
+    REQUIRE(scene_loader.spheres().back().radius == 0.25F);
+
+    physics_engine.cleanup();
+}
+
+TEST_CASE("Static boxes sharing a cell are merged into one body", "[scene]")
+{
+    PhysicsEngine physics_engine{};
+    SceneLoader scene_loader{physics_engine};
+    REQUIRE(parse("world bodies 16 merge_cell 10\n"
+                  "box static position 1 0 1 half_extents 0.5 0.5 0.5\n"
+                  "box static position 2 0 1 half_extents 0.5 0.5 0.5\n"
+                  "box static position 3 0 1 half_extents 0.5 0.5 0.5\n"
+                  "box static position 15 0 1 half_extents 0.5 0.5 0.5\n"
+                  "sphere dynamic position 2 4 1 radius 0.5\n",
+                  scene_loader,
+                  2));
+    physics_engine.start_simulation();
+
+    REQUIRE(scene_loader.body_count() == 5);
+    REQUIRE(scene_loader.world_body_count() == 3);
+    REQUIRE(physics_engine.get_num_bodies() == 3);
+
+    const JPH::BodyID sphere{scene_loader.spheres().front().id};
+    uint32_t entity{0};
+    REQUIRE(scene_loader.entity_for(sphere, JPH::SubShapeID{}, entity));
+    REQUIRE(entity == 4);
+
+    // The sphere comes to rest on the merged boxes rather than falling through
+    for (int step{0}; step < 120; ++step)
+    {
+        physics_engine.step(1.F / 60.F);
+    }
+    Vec3 position{};
+    REQUIRE(physics_engine.get_body_position(sphere, position));
+    REQUIRE(position.y > 0.9F);
+
+    // Dropping one merged box rebuilds the compound from the two left
+    const std::string reloaded{
+        "world bodies 16 merge_cell 10\n"
+        "box static position 1 0 1 half_extents 0.5 0.5 0.5\n"
+        "box static position 3 0 1 half_extents 0.5 0.5 0.5\n"
+        "box static position 15 0 1 half_extents 0.5 0.5 0.5\n"
+        "sphere dynamic position 2 4 1 radius 0.5\n"};
+    REQUIRE(scene_loader.reload([&reloaded](SceneSink &sink)
+                                { return parse(reloaded, sink); }));
+    REQUIRE(scene_loader.body_count() == 4);
+    REQUIRE(scene_loader.world_body_count() == 3);
+    REQUIRE(physics_engine.get_num_bodies() == 3);
+    REQUIRE(scene_loader.spheres().front().id == sphere);
+
+    physics_engine.cleanup();
+}
+
+TEST_CASE("Hard hits break parts off destructibles", "[scene]")
+{
+    PhysicsEngine physics_engine{};
+    SceneLoader scene_loader{physics_engine};
+    REQUIRE(parse("world bodies 64\n"
+                  "destructible static position 0 1 0 parts 3 3 1 "
+                  "part_radius 0.5 threshold 50 detach\n"
+                  "sphere dynamic position 0 1 -4 radius 0.5 velocity 0 0 20\n",
+                  scene_loader));
+    physics_engine.start_simulation();
+
+    DestructibleSystem destructible_system{physics_engine};
+    destructible_system.set_destructibles(scene_loader.destructibles());
+    REQUIRE(destructible_system.capacity() == 9);
+    REQUIRE(destructible_system.spheres().size() == 9);
+    REQUIRE(physics_engine.get_num_bodies() == 2);
+
+    // The ball hits the middle of the wall within a few steps, and the parts
+    // it touches come away as balls of their own
+    for (int step{0}; step < 30; ++step)
+    {
+        physics_engine.step(1.F / 60.F);
+        destructible_system.update();
+        REQUIRE(destructible_system.stats().objects_changed_last_update <= 1);
+    }
+    const DestructibleStats &stats{destructible_system.stats()};
+    REQUIRE(stats.parts_broken_total > 0);
+    REQUIRE(stats.parts_broken_total < 9);
+    REQUIRE(destructible_system.spheres().size() == 9);
+    REQUIRE(physics_engine.get_num_bodies() == 2 + stats.parts_broken_total);
+
+    destructible_system.clear();
+    REQUIRE(physics_engine.get_num_bodies() == 1);
+    physics_engine.cleanup();
+}
+
+TEST_CASE("Spawners emit at their rate and despawn below the kill plane",
+          "[scene]")
+{
+    PhysicsEngine physics_engine{};
+    SceneLoader scene_loader{physics_engine};
+    REQUIRE(parse("world bodies 64\n"
+                  "spawner position 0 0 0 area 2 0 2 velocity 0 -10 0 "
+                  "velocity_spread 1 0 1 radius 0.25 rate 60 limit 20 "
+                  "kill_y -2\n",
+                  scene_loader));
+    physics_engine.start_simulation();
+    REQUIRE(scene_loader.spawners().size() == 1);
+    REQUIRE(scene_loader.spawners().front().velocity_spread.x == 1.F);
+
+    SpawnerSystem spawner_system{physics_engine};
+    spawner_system.set_spawners(scene_loader.spawners());
+    REQUIRE(spawner_system.capacity() == 20);
+
+    constexpr float kStep{1.F / 60.F};
+    spawner_system.update(kStep);
+    REQUIRE(spawner_system.stats().spawned_last_update == 1);
+    REQUIRE(physics_engine.get_num_bodies() == 1);
+
+    // With nothing to land on, every ball falls through the kill plane, so
+    // bodies keep being replaced without passing the limit
+    for (int step{0}; step < 120; ++step)
+    {
+        physics_engine.step(kStep);
+        spawner_system.update(kStep);
+        REQUIRE(spawner_system.stats().live_bodies <= 20);
+    }
+    const SpawnerStats &stats{spawner_system.stats()};
+    REQUIRE(stats.despawned_total > 0);
+    REQUIRE(stats.spawned_total == stats.despawned_total + stats.live_bodies);
+    REQUIRE(physics_engine.get_num_bodies() == stats.live_bodies);
+    REQUIRE(spawner_system.spheres().size() == stats.live_bodies);
+
+    spawner_system.clear();
+    REQUIRE(physics_engine.get_num_bodies() == 0);
+    physics_engine.cleanup();
+}
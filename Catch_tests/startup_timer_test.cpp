@@ -0,0 +1,44 @@
+#include "startup_timer.h"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <future>
+#include <vector>
+
+namespace
+{
+using Clock = StartupTimer::Clock;
+using std::chrono::milliseconds;
+} // namespace
+
+TEST_CASE("Phases are listed in start order with their thread",
+          "[startup_timer]")
+{
+    StartupTimer timer{};
+    const Clock::time_point now{Clock::now()};
+    timer.record("second", now + milliseconds{10}, now + milliseconds{30});
+    std::async(std::launch::async,
+               [&timer, now]()
+               { timer.record("first", now, now + milliseconds{20}); })
+        .get();
+
+    const std::vector<StartupPhase> phases{timer.phases()};
+    REQUIRE(phases.size() == 2);
+    REQUIRE(phases.at(0).name == "first");
+    REQUIRE_FALSE(phases.at(0).main_thread);
+    REQUIRE(phases.at(1).name == "second");
+    REQUIRE(phases.at(1).main_thread);
+    REQUIRE(phases.at(1).end_milliseconds - phases.at(1).start_milliseconds ==
+            Catch::Approx(20.F));
+}
+
+TEST_CASE("Timing a phase returns the function's result", "[startup_timer]")
+{
+    StartupTimer timer{};
+    REQUIRE(timer.time("answer", []() { return 42; }) == 42);
+    timer.time("nothing", []() {});
+    REQUIRE(timer.phases().size() == 2);
+    REQUIRE(timer.time_to_first_frame_milliseconds() == 0.F);
+}
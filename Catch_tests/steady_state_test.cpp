@@ -0,0 +1,29 @@
+#include "allocation_counter.h"
+#include "headless/headless_loop.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+
+TEST_CASE("Headless loop makes no heap allocations once warmed up",
+          "[allocation]")
+{
+    constexpr int kWarmUpSteps{240};
+    constexpr int kMeasuredSteps{240};
+
+    HeadlessLoop loop{};
+    for (int step{0}; step < kWarmUpSteps; ++step)
+    {
+        loop.step();
+    }
+
+    const uint64_t allocations_before{allocation_counter::count()};
+    for (int step{0}; step < kMeasuredSteps; ++step)
+    {
+        loop.step();
+    }
+    const uint64_t allocations{allocation_counter::count() -
+                               allocations_before};
+
+    REQUIRE(allocations == 0);
+}
@@ -0,0 +1,71 @@
+#include "headless/thread_scaling.h"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+// One result per thread count, starting at one thread
+ThreadScalingReport report_with_medians(const std::vector<float> &medians)
+{
+    ThreadScalingReport report{};
+    for (std::size_t index{0}; index < medians.size(); ++index)
+    {
+        ThreadScalingResult result{};
+        result.threads = static_cast<int>(index) + 1;
+        result.p50_milliseconds = medians[index];
+        report.results.push_back(result);
+    }
+    return report;
+}
+} // namespace
+
+TEST_CASE("Thread scaling speedup is relative to the single thread median",
+          "[thread_scaling]")
+{
+    ThreadScalingReport report{report_with_medians({12.F, 6.F, 4.F, 3.F})};
+    summarise_thread_scaling(report);
+
+    REQUIRE(report.results[0].speedup == Catch::Approx(1.F));
+    REQUIRE(report.results[0].efficiency == Catch::Approx(1.F));
+    REQUIRE(report.results[1].speedup == Catch::Approx(2.F));
+    REQUIRE(report.results[1].efficiency == Catch::Approx(1.F));
+    REQUIRE(report.results[3].speedup == Catch::Approx(4.F));
+    REQUIRE(report.results[3].efficiency == Catch::Approx(1.F));
+}
+
+TEST_CASE("Thread scaling knee is the fewest threads near the fastest median",
+          "[thread_scaling]")
+{
+    // Three threads are within 5% of the fastest run; more only add noise
+    ThreadScalingReport report{
+        report_with_medians({10.F, 6.F, 4.1F, 4.F, 4.05F, 4.2F})};
+    summarise_thread_scaling(report);
+
+    REQUIRE(report.knee_threads == 3);
+    REQUIRE(report.results[5].speedup < report.results[3].speedup);
+    REQUIRE(report.results[5].efficiency == Catch::Approx(10.F / 4.2F / 6.F));
+}
+
+TEST_CASE("Thread scaling knee is one thread when threads do not help",
+          "[thread_scaling]")
+{
+    ThreadScalingReport report{report_with_medians({5.F, 5.5F, 6.F})};
+    summarise_thread_scaling(report);
+
+    REQUIRE(report.knee_threads == 1);
+    REQUIRE(report.results[2].speedup < 1.F);
+}
+
+TEST_CASE("Thread scaling of an empty report leaves it empty",
+          "[thread_scaling]")
+{
+    ThreadScalingReport report{};
+    summarise_thread_scaling(report);
+
+    REQUIRE(report.results.empty());
+    REQUIRE(report.knee_threads == 0);
+}
@@ -0,0 +1,54 @@
+#include "tuning.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+bool parse(const std::string &text, Tuning &tuning)
+{
+    std::istringstream stream{text};
+    return tuning_file::parse(stream, "test.cfg", tuning);
+}
+} // namespace
+
+TEST_CASE("Tuning values are read by name", "[tuning]")
+{
+    Tuning tuning{};
+    REQUIRE(parse("tickrate 30 # half speed\n"
+                  "\n"
+                  "camera_position 1 2 3\n"
+                  "gravity 0 -1.5 0\n"
+                  "velocity_steps 4\n"
+                  "allow_sleeping off\n",
+                  tuning));
+    REQUIRE(tuning.tickrate == 30);
+    REQUIRE(tuning.camera_position.z == 3.F);
+    REQUIRE(tuning.physics.gravity.y == -1.5F);
+    REQUIRE(tuning.physics.velocity_steps == 4);
+    REQUIRE_FALSE(tuning.physics.allow_sleeping);
+    REQUIRE(tuning.kick_speed == Tuning{}.kick_speed);
+}
+
+TEST_CASE("Values left out of a tuning file take their defaults", "[tuning]")
+{
+    Tuning tuning{};
+    tuning.kick_speed = 9.F;
+    tuning.physics.baumgarte = 0.5F;
+    REQUIRE(parse("tickrate 30\n", tuning));
+    REQUIRE(tuning.kick_speed == Tuning{}.kick_speed);
+    REQUIRE(tuning.physics == PhysicsTuning{});
+}
+
+TEST_CASE("A bad tuning file leaves the tuning untouched", "[tuning]")
+{
+    Tuning tuning{};
+    tuning.tickrate = 20;
+    REQUIRE_FALSE(parse("tickrate 30\nkick_speed fast\n", tuning));
+    REQUIRE_FALSE(parse("tickrate 0\n", tuning));
+    REQUIRE_FALSE(parse("camera_position 1 2\n", tuning));
+    REQUIRE_FALSE(parse("frame_rate 60\n", tuning));
+    REQUIRE(tuning.tickrate == 20);
+}
@@ -33,17 +33,45 @@ set(FLOATING_POINT_EXCEPTIONS_ENABLED OFF)
 # Number of bits to use in ObjectLayer. Can be 16 or 32.
 set(OBJECT_LAYER_BITS 16)
 
-# Select X86 processor features to use, by default the library compiles with
-# AVX2, if everything is off it will be SSE2 compatible.
-set(USE_SSE4_1 ON)
-set(USE_SSE4_2 ON)
-set(USE_AVX ON)
-set(USE_AVX2 ON)
+# Select X86 processor features to use. JOLT_RAYLIB_ISA picks a level and sets
+# the matching Jolt USE_* options. Jolt's SIMD code is inlined into our code
+# through its headers, so the whole build targets one level. Set
+# JOLT_RAYLIB_ISA_VARIANTS to also build a variant per level, with a launcher
+# that picks one at startup (see cmake/IsaVariants.cmake).
+set(JOLT_RAYLIB_ISA
+    "AVX2"
+    CACHE STRING "Instruction set level: SSE2, SSE4_2, AVX2 or AVX512")
+set_property(CACHE JOLT_RAYLIB_ISA PROPERTY STRINGS SSE2 SSE4_2 AVX2 AVX512)
+
+set(USE_SSE4_1 OFF)
+set(USE_SSE4_2 OFF)
+set(USE_AVX OFF)
+set(USE_AVX2 OFF)
 set(USE_AVX512 OFF)
-set(USE_LZCNT ON)
-set(USE_TZCNT ON)
-set(USE_F16C ON)
-set(USE_FMADD ON)
+set(USE_LZCNT OFF)
+set(USE_TZCNT OFF)
+set(USE_F16C OFF)
+set(USE_FMADD OFF)
+if(JOLT_RAYLIB_ISA STREQUAL "SSE2")
+  # Everything off is SSE2 compatible
+elseif(JOLT_RAYLIB_ISA STREQUAL "SSE4_2")
+  set(USE_SSE4_1 ON)
+  set(USE_SSE4_2 ON)
+elseif(JOLT_RAYLIB_ISA STREQUAL "AVX2" OR JOLT_RAYLIB_ISA STREQUAL "AVX512")
+  set(USE_SSE4_1 ON)
+  set(USE_SSE4_2 ON)
+  set(USE_AVX ON)
+  set(USE_AVX2 ON)
+  set(USE_LZCNT ON)
+  set(USE_TZCNT ON)
+  set(USE_F16C ON)
+  set(USE_FMADD ON)
+  if(JOLT_RAYLIB_ISA STREQUAL "AVX512")
+    set(USE_AVX512 ON)
+  endif()
+else()
+  message(FATAL_ERROR "JOLT_RAYLIB_ISA must be SSE2, SSE4_2, AVX2 or AVX512")
+endif()
 
 # Requires C++ 17
 set(CMAKE_CXX_STANDARD 17)
@@ -90,6 +118,9 @@ function(jolt_raylib_hello_world_setup_dependencies)
   cpmaddpackage("gh:gabime/spdlog#7c02e204c92545f869e2f04edaab1f19fe8b19fd"
   )# v1.13.0
 
+  message(STATUS "Include nlohmann_json")
+  cpmaddpackage("gh:nlohmann/json@3.11.3")
+
   message(STATUS "Include rlImGui")
   FetchContent_Declare(
     rlImGui
@@ -0,0 +1,97 @@
+# Build speed options. They are off by default, since whether they help depends
+# on the compiler, generator and core count; measure with
+# JOLT_RAYLIB_BUILD_TIMING before turning them on for CI.
+#
+# JOLT_RAYLIB_PRECOMPILED_HEADERS precompiles the Jolt, spdlog, raylib and
+# Dear ImGui headers each target includes. Most of our translation units
+# include some Jolt headers, and those are far larger than our own code.
+#
+# JOLT_RAYLIB_UNITY_BUILD compiles our targets and Jolt as unity builds, which
+# combine several source files into one translation unit so shared headers
+# are parsed once per batch. Names in anonymous namespaces must stay unique
+# across the files of a target for this to work.
+#
+# JOLT_RAYLIB_BUILD_TIMING reports how long each compile and link takes.
+# With Clang it also writes a -ftime-trace JSON file per object, which can be
+# opened in chrome://tracing or Perfetto to see which headers cost the most.
+
+option(JOLT_RAYLIB_PRECOMPILED_HEADERS "Precompile third party headers" OFF)
+option(JOLT_RAYLIB_UNITY_BUILD "Build our targets and Jolt as unity builds"
+       OFF)
+option(JOLT_RAYLIB_BUILD_TIMING "Report compile and link times" OFF)
+set(JOLT_RAYLIB_UNITY_BUILD_BATCH_SIZE
+    "8"
+    CACHE STRING "Source files combined into each unity build file")
+
+# Headers shared by the targets that use Jolt. Jolt.h must come first.
+set(jolt_raylib_jolt_headers
+    <Jolt/Jolt.h>
+    <Jolt/Core/JobSystemThreadPool.h>
+    <Jolt/Core/TempAllocator.h>
+    <Jolt/Physics/Body/BodyCreationSettings.h>
+    <Jolt/Physics/Body/BodyInterface.h>
+    <Jolt/Physics/Collision/Shape/BoxShape.h>
+    <Jolt/Physics/Collision/Shape/SphereShape.h>
+    <Jolt/Physics/PhysicsSystem.h>)
+set(jolt_raylib_common_headers
+    <spdlog/spdlog.h>
+    <fmt/core.h>
+    <algorithm>
+    <chrono>
+    <filesystem>
+    <string>
+    <vector>)
+
+# Precompiles headers for a target. The common headers are always added, then
+# any of JOLT, RAYLIB, IMGUI or JSON.
+function(jolt_raylib_precompile_headers target)
+    if (NOT JOLT_RAYLIB_PRECOMPILED_HEADERS)
+        return()
+    endif()
+
+    set(headers)
+    if (JOLT IN_LIST ARGN)
+        list(APPEND headers ${jolt_raylib_jolt_headers})
+    endif()
+    list(APPEND headers ${jolt_raylib_common_headers})
+    if (RAYLIB IN_LIST ARGN)
+        list(APPEND headers <raylib.h>)
+    endif()
+    if (IMGUI IN_LIST ARGN)
+        list(APPEND headers <imgui.h>)
+    endif()
+    if (JSON IN_LIST ARGN)
+        list(APPEND headers <nlohmann/json.hpp>)
+    endif()
+    target_precompile_headers(${target} PRIVATE ${headers})
+endfunction()
+
+function(jolt_raylib_enable_unity_build target)
+    if (NOT JOLT_RAYLIB_UNITY_BUILD)
+        return()
+    endif()
+    set_target_properties(
+        ${target}
+        PROPERTIES UNITY_BUILD ON UNITY_BUILD_BATCH_SIZE
+                                  ${JOLT_RAYLIB_UNITY_BUILD_BATCH_SIZE})
+endfunction()
+
+if (JOLT_RAYLIB_BUILD_TIMING)
+    if (CMAKE_GENERATOR MATCHES "Makefiles|Ninja")
+        # Prints the elapsed time after every compile and link
+        set_property(GLOBAL PROPERTY RULE_LAUNCH_COMPILE
+                                     "${CMAKE_COMMAND} -E time")
+        set_property(GLOBAL PROPERTY RULE_LAUNCH_LINK
+                                     "${CMAKE_COMMAND} -E time")
+    else()
+        message(WARNING "JOLT_RAYLIB_BUILD_TIMING needs a Makefile or Ninja "
+                        "generator, use the IDE's build timing instead")
+    endif()
+endif()
+
+# Clang time traces for a target, written next to each object file
+function(jolt_raylib_enable_build_timing target)
+    if (JOLT_RAYLIB_BUILD_TIMING AND CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        target_compile_options(${target} PRIVATE -ftime-trace)
+    endif()
+endfunction()
@@ -0,0 +1,51 @@
+# Runs the perf check with each instruction set variant this CPU supports and
+# prints the step times side by side. Run in script mode with LAUNCHER (the
+# headless launcher), VARIANTS (comma separated), BASELINE and
+# OUTPUT_DIRECTORY defined.
+# Variants are run through the launcher with JOLT_RAYLIB_ISA set, so a variant
+# this CPU cannot run is skipped instead of crashing.
+
+cmake_minimum_required(VERSION 3.19) # string(JSON)
+
+string(REPLACE "," ";" VARIANTS "${VARIANTS}")
+set(metrics hello_world_step_ms scene_1000_step_ms scene_10000_step_ms)
+file(MAKE_DIRECTORY ${OUTPUT_DIRECTORY})
+
+set(table "")
+foreach(variant IN LISTS VARIANTS)
+    execute_process(COMMAND ${LAUNCHER} --isa-supported ${variant}
+                    RESULT_VARIABLE supported)
+    if (NOT supported EQUAL 0)
+        string(APPEND table "${variant}: not supported by this CPU\n")
+        continue()
+    endif()
+
+    string(TOLOWER ${variant} suffix)
+    set(results ${OUTPUT_DIRECTORY}/${suffix}.json)
+    file(REMOVE ${results})
+    set(ENV{JOLT_RAYLIB_ISA} ${variant})
+    # A regression against the baseline should not stop the matrix, so the
+    # exit code is ignored and the results file checked instead
+    execute_process(COMMAND ${LAUNCHER} --perf-check ${BASELINE}
+                            --perf-results ${results})
+    if (NOT EXISTS ${results})
+        string(APPEND table "${variant}: perf check failed\n")
+        continue()
+    endif()
+
+    file(READ ${results} json)
+    string(APPEND table "${variant}:")
+    foreach(metric IN LISTS metrics)
+        string(JSON value ERROR_VARIABLE error GET ${json} metrics ${metric}
+               value)
+        if (error)
+            set(value "-")
+        endif()
+        string(APPEND table " ${metric} ${value}")
+    endforeach()
+    string(APPEND table "\n")
+endforeach()
+unset(ENV{JOLT_RAYLIB_ISA})
+
+message(STATUS "Median step time in milliseconds per variant:\n${table}")
+message(STATUS "Full results are in ${OUTPUT_DIRECTORY}")
@@ -0,0 +1,108 @@
+# Builds the game and headless runner once per instruction set level, for
+# machines that differ in which SIMD extensions they have. Jolt's vector code
+# is inlined through its headers into every translation unit that uses it, so
+# levels cannot be mixed in one executable, and picking code paths at run time
+# inside the process is not possible without rebuilding Jolt's math library
+# around function pointers. Instead each level is a separate build of this
+# project, and a small launcher reads CPUID at startup and execs the best one.
+#
+#   cmake -DJOLT_RAYLIB_ISA_VARIANTS="SSE4_2;AVX2;AVX512" ..
+#
+# puts JoltRaylibHelloWorld-sse4_2, -avx2 and -avx512 next to the normal
+# binaries, along with JoltRaylibHelloWorldLauncher and
+# JoltRaylibHelloWorldHeadlessLauncher. The isa_benchmark_matrix target runs
+# the perf check with each variant this CPU supports and tabulates step times.
+
+include(ExternalProject)
+
+set(JOLT_RAYLIB_ISA_VARIANTS
+    ""
+    CACHE STRING
+          "Instruction set levels to build variants for, such as SSE4_2;AVX2")
+
+set(jolt_raylib_isa_programs JoltRaylibHelloWorld JoltRaylibHelloWorldHeadless)
+
+function(jolt_raylib_add_isa_variants)
+    if (NOT JOLT_RAYLIB_ISA_VARIANTS)
+        return()
+    endif()
+
+    # Point the variant builds at the dependency sources already fetched, so
+    # they are downloaded once
+    FetchContent_GetProperties(ImGui SOURCE_DIR imgui_source)
+    FetchContent_GetProperties(JoltPhysics SOURCE_DIR jolt_source)
+    FetchContent_GetProperties(rlImGui SOURCE_DIR rlimgui_source)
+    set(dependency_arguments
+        -DFETCHCONTENT_SOURCE_DIR_IMGUI=${imgui_source}
+        -DFETCHCONTENT_SOURCE_DIR_JOLTPHYSICS=${jolt_source}
+        -DFETCHCONTENT_SOURCE_DIR_RLIMGUI=${rlimgui_source})
+    foreach(package dbg-macro fmt raylib spdlog json)
+        list(APPEND dependency_arguments
+             -DCPM_${package}_SOURCE=${CPM_PACKAGE_${package}_SOURCE_DIR})
+    endforeach()
+
+    get_property(multi_config GLOBAL PROPERTY GENERATOR_IS_MULTI_CONFIG)
+    set(variant_binaries "bin")
+    if (multi_config)
+        set(variant_binaries "bin/$<CONFIG>")
+    endif()
+
+    set(variant_suffixes)
+    foreach(variant IN LISTS JOLT_RAYLIB_ISA_VARIANTS)
+        string(TOLOWER ${variant} suffix)
+        list(APPEND variant_suffixes ${suffix})
+
+        set(install_commands)
+        foreach(program IN LISTS jolt_raylib_isa_programs)
+            list(APPEND install_commands
+                 COMMAND ${CMAKE_COMMAND} -E copy
+                         <BINARY_DIR>/${variant_binaries}/${program}${CMAKE_EXECUTABLE_SUFFIX}
+                         $<TARGET_FILE_DIR:JoltRaylibHelloWorld>/${program}-${suffix}${CMAKE_EXECUTABLE_SUFFIX})
+        endforeach()
+
+        ExternalProject_Add(
+            jolt_raylib_isa_${suffix}
+            SOURCE_DIR ${PROJECT_SOURCE_DIR}
+            BINARY_DIR ${CMAKE_BINARY_DIR}/isa/${suffix}
+            CMAKE_ARGS -DJOLT_RAYLIB_ISA=${variant}
+                       -DJOLT_RAYLIB_ISA_VARIANTS=
+                       -DRUN_UNIT_TESTS=OFF
+                       -DCMAKE_BUILD_TYPE=${CMAKE_BUILD_TYPE}
+                       -DCMAKE_C_COMPILER=${CMAKE_C_COMPILER}
+                       -DCMAKE_CXX_COMPILER=${CMAKE_CXX_COMPILER}
+                       ${dependency_arguments}
+            BUILD_COMMAND ${CMAKE_COMMAND} --build <BINARY_DIR> --config
+                          $<CONFIG> --target ${jolt_raylib_isa_programs}
+            INSTALL_COMMAND ${install_commands}
+            BUILD_ALWAYS ON
+            USES_TERMINAL_BUILD ON)
+    endforeach()
+
+    foreach(program IN LISTS jolt_raylib_isa_programs)
+        add_executable(${program}Launcher
+                       ${PROJECT_SOURCE_DIR}/src/tools/isa_launcher.cpp)
+        target_compile_definitions(${program}Launcher
+                                   PRIVATE ISA_LAUNCHER_PROGRAM="${program}")
+        target_link_libraries(
+            ${program}Launcher PRIVATE jolt_raylib_support
+                                       jolt_raylib_hello_world_compiler_flags)
+        foreach(suffix IN LISTS variant_suffixes)
+            add_dependencies(${program}Launcher jolt_raylib_isa_${suffix})
+        endforeach()
+    endforeach()
+
+    # Commas, since a list would be split into separate command arguments
+    string(REPLACE ";" "," variants "${JOLT_RAYLIB_ISA_VARIANTS}")
+    add_custom_target(
+        isa_benchmark_matrix
+        COMMAND
+            ${CMAKE_COMMAND}
+            -DLAUNCHER=$<TARGET_FILE:JoltRaylibHelloWorldHeadlessLauncher>
+            -DVARIANTS=${variants}
+            -DBASELINE=${PROJECT_SOURCE_DIR}/perf/baseline.json
+            -DOUTPUT_DIRECTORY=${CMAKE_BINARY_DIR}/isa_benchmarks
+            -P ${PROJECT_SOURCE_DIR}/cmake/IsaBenchmarkMatrix.cmake
+        DEPENDS JoltRaylibHelloWorldHeadlessLauncher
+        COMMENT "Benchmarking each instruction set variant"
+        USES_TERMINAL)
+endfunction()
@@ -0,0 +1,137 @@
+# Profile guided optimisation in two phases, in the same build directory:
+#
+#   cmake -DJOLT_RAYLIB_PGO=GENERATE -DCMAKE_BUILD_TYPE=Distribution ..
+#   cmake --build . --target pgo_train
+#   cmake -DJOLT_RAYLIB_PGO=USE ..
+#   cmake --build .
+#
+# GENERATE builds instrumented binaries, pgo_train runs the headless runner to
+# collect a profile, and USE rebuilds with the profile applied. Pass every
+# target that should be optimised, including Jolt, to jolt_raylib_enable_pgo.
+#
+# To compare with a build without PGO, record reference timings with a
+# JOLT_RAYLIB_PGO=OFF build first, using --perf-results to write them to
+# JOLT_RAYLIB_PGO_REFERENCE. The pgo_compare target in the USE build then
+# checks against that file, logging the change in each metric.
+
+set(JOLT_RAYLIB_PGO
+    "OFF"
+    CACHE STRING "Profile guided optimisation phase: OFF, GENERATE or USE")
+set_property(CACHE JOLT_RAYLIB_PGO PROPERTY STRINGS OFF GENERATE USE)
+set(JOLT_RAYLIB_PGO_DIRECTORY
+    "${CMAKE_BINARY_DIR}/pgo"
+    CACHE PATH "Where training profiles are written and read")
+set(JOLT_RAYLIB_PGO_REFERENCE
+    "${CMAKE_BINARY_DIR}/pgo_reference.json"
+    CACHE FILEPATH "Perf results from a build without PGO, for pgo_compare")
+
+if (NOT JOLT_RAYLIB_PGO STREQUAL "OFF"
+    AND NOT JOLT_RAYLIB_PGO STREQUAL "GENERATE"
+    AND NOT JOLT_RAYLIB_PGO STREQUAL "USE")
+    message(FATAL_ERROR "JOLT_RAYLIB_PGO must be OFF, GENERATE or USE")
+endif()
+
+if (NOT JOLT_RAYLIB_PGO STREQUAL "OFF" AND CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    find_program(LLVM_PROFDATA NAMES llvm-profdata)
+    if (NOT LLVM_PROFDATA)
+        message(FATAL_ERROR "llvm-profdata is needed to merge Clang profiles")
+    endif()
+endif()
+
+set(JOLT_RAYLIB_PGO_CLANG_PROFILE "${JOLT_RAYLIB_PGO_DIRECTORY}/merged.profdata")
+
+function(jolt_raylib_enable_pgo target)
+    if (JOLT_RAYLIB_PGO STREQUAL "OFF")
+        return()
+    endif()
+
+    set(directory "${JOLT_RAYLIB_PGO_DIRECTORY}")
+    if (CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        if (JOLT_RAYLIB_PGO STREQUAL "GENERATE")
+            # The physics step runs on several threads, so counters must be
+            # updated atomically to stay accurate
+            set(options -fprofile-generate=${directory}
+                        -fprofile-update=atomic)
+        else()
+            # Code the training run never reached has no profile, which is
+            # expected rather than an error under -Werror
+            set(options -fprofile-use=${directory} -fprofile-correction
+                        -Wno-missing-profile)
+        endif()
+        target_compile_options(${target} PRIVATE ${options})
+        target_link_options(${target} PRIVATE ${options})
+    elseif (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        if (JOLT_RAYLIB_PGO STREQUAL "GENERATE")
+            set(options -fprofile-instr-generate=${directory}/%m-%p.profraw)
+        else()
+            set(options -fprofile-instr-use=${JOLT_RAYLIB_PGO_CLANG_PROFILE}
+                        -Wno-profile-instr-unprofiled
+                        -Wno-profile-instr-out-of-date)
+        endif()
+        target_compile_options(${target} PRIVATE ${options})
+        target_link_options(${target} PRIVATE ${options})
+    elseif (MSVC)
+        # MSVC profiles at link time, so the code must be compiled for whole
+        # program optimisation. Static libraries are profiled through the
+        # executables they are linked into.
+        target_compile_options(${target} PRIVATE /GL)
+        get_target_property(type ${target} TYPE)
+        if (type STREQUAL "EXECUTABLE")
+            set(database "${directory}/${target}.pgd")
+            if (JOLT_RAYLIB_PGO STREQUAL "GENERATE")
+                target_link_options(${target} PRIVATE /LTCG
+                                    /GENPROFILE:PGD=${database})
+            else()
+                target_link_options(${target} PRIVATE /LTCG
+                                    /USEPROFILE:PGD=${database})
+            endif()
+        else()
+            set_property(TARGET ${target} APPEND PROPERTY STATIC_LIBRARY_OPTIONS
+                                                          /LTCG)
+        endif()
+    else()
+        message(WARNING "Profile guided optimisation is not supported for "
+                        "${CMAKE_CXX_COMPILER_ID}")
+    endif()
+endfunction()
+
+# Adds pgo_train to a GENERATE build and pgo_compare to a USE build. pgo_train
+# runs the training workload with the instrumented binaries: the headless
+# runner steps the hello world scene, then the benchmark scene across thread
+# counts, so the profile covers single threaded and job system code paths.
+function(jolt_raylib_add_pgo_targets runner)
+    if (JOLT_RAYLIB_PGO STREQUAL "USE")
+        add_custom_target(
+            pgo_compare
+            COMMAND $<TARGET_FILE:${runner}> --perf-check
+                    ${JOLT_RAYLIB_PGO_REFERENCE} --perf-results
+                    ${CMAKE_BINARY_DIR}/pgo_results.json
+            DEPENDS ${runner}
+            COMMENT "Comparing against ${JOLT_RAYLIB_PGO_REFERENCE}"
+            USES_TERMINAL)
+    endif()
+    if (NOT JOLT_RAYLIB_PGO STREQUAL "GENERATE")
+        return()
+    endif()
+
+    set(commands
+        COMMAND ${CMAKE_COMMAND} -E remove_directory ${JOLT_RAYLIB_PGO_DIRECTORY}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${JOLT_RAYLIB_PGO_DIRECTORY}
+        COMMAND $<TARGET_FILE:${runner}> --steps 2000
+        COMMAND $<TARGET_FILE:${runner}> --thread-scaling --bodies 10000
+                --steps 300 --max-worker-threads 3)
+    if (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        list(APPEND commands
+             COMMAND ${CMAKE_COMMAND} -DLLVM_PROFDATA=${LLVM_PROFDATA}
+                     -DDIRECTORY=${JOLT_RAYLIB_PGO_DIRECTORY}
+                     -DOUTPUT=${JOLT_RAYLIB_PGO_CLANG_PROFILE}
+                     -P ${PROJECT_SOURCE_DIR}/cmake/PGOMerge.cmake)
+    endif()
+
+    add_custom_target(
+        pgo_train
+        ${commands}
+        DEPENDS ${runner}
+        COMMENT "Collecting profiles in ${JOLT_RAYLIB_PGO_DIRECTORY}"
+        USES_TERMINAL)
+endfunction()
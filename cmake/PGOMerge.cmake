@@ -0,0 +1,13 @@
+# Merges Clang's raw profiles into the single file -fprofile-instr-use reads.
+# Run in script mode with LLVM_PROFDATA, DIRECTORY and OUTPUT defined.
+
+file(GLOB profiles "${DIRECTORY}/*.profraw")
+if (NOT profiles)
+    message(FATAL_ERROR "No .profraw files in ${DIRECTORY}, run the training "
+                        "workload with an instrumented build first")
+endif()
+execute_process(COMMAND ${LLVM_PROFDATA} merge -output=${OUTPUT} ${profiles}
+                RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "llvm-profdata merge failed")
+endif()
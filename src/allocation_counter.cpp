@@ -0,0 +1,92 @@
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace
+{
+std::atomic<uint64_t> allocations{0};
+} // namespace
+
+namespace allocation_counter
+{
+void record()
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t count()
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+} // namespace allocation_counter
+
+// Replacing the plain operator new is enough to see every allocation from the
+// array and nothrow forms too, as their default versions forward to it. The
+// matching deletes are replaced so both sides agree on malloc and free.
+void *operator new(std::size_t size)
+{
+    allocation_counter::record();
+    void *pointer{std::malloc(size == 0 ? 1 : size)}; // NOLINT [cppcoreguidelines-no-malloc]
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc{};
+    }
+    return pointer;
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer); // NOLINT [cppcoreguidelines-no-malloc]
+}
+
+void operator delete(void *pointer, std::size_t /* size */) noexcept
+{
+    std::free(pointer); // NOLINT [cppcoreguidelines-no-malloc]
+}
+
+// Over-aligned types, such as Jolt's SIMD vectors held in standard containers,
+// use the aligned forms instead, which do not forward to the plain one
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    allocation_counter::record();
+    const auto bytes{size == 0 ? std::size_t{1} : size};
+    const auto align{static_cast<std::size_t>(alignment)};
+#ifdef _WIN32
+    void *pointer{_aligned_malloc(bytes, align)};
+#else
+    void *pointer{nullptr};
+    if (posix_memalign(&pointer, align, bytes) != 0)
+    {
+        pointer = nullptr;
+    }
+#endif
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc{};
+    }
+    return pointer;
+}
+
+void operator delete(void *pointer, std::align_val_t /* alignment */) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    std::free(pointer); // NOLINT [cppcoreguidelines-no-malloc]
+#endif
+}
+
+void operator delete(void *pointer,
+                     std::size_t /* size */,
+                     std::align_val_t alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
@@ -0,0 +1,19 @@
+#ifndef SRC_ALLOCATION_COUNTER_H
+#define SRC_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+// Counts heap allocations made through C++ new and through allocators that
+// report to it. Linking allocation_counter.cpp replaces the global operator
+// new, plain and aligned, the physics engine routes Jolt's allocation hooks
+// through record(), and the game does the same for Dear ImGui. Memory C
+// libraries take straight from malloc, such as raylib's and stb's, is not
+// seen, so a zero means no counted allocations rather than no heap use at all.
+// Compare two readings to get the allocations made in between.
+namespace allocation_counter
+{
+void record();
+[[nodiscard]] uint64_t count();
+} // namespace allocation_counter
+
+#endif
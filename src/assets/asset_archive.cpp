@@ -0,0 +1,305 @@
+#include "asset_archive.h"
+
+#include "asset_archive_format.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+struct PackedFile
+{
+    std::filesystem::path path{};
+    std::string name{};
+    uint64_t size{0};
+};
+
+uint64_t align_up(const uint64_t offset)
+{
+    const uint64_t alignment{asset_archive::kAlignment};
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+void write_padding(std::ofstream &stream, const uint64_t to_offset)
+{
+    constexpr std::array<char, asset_archive::kAlignment> kZeros{};
+    const auto position{static_cast<uint64_t>(stream.tellp())};
+    stream.write(kZeros.data(),
+                 static_cast<std::streamsize>(to_offset - position));
+}
+
+// Whether size bytes from offset fit in total bytes. Compares by subtraction,
+// so a corrupt offset or size cannot wrap the sum back into range.
+bool fits_within(const uint64_t offset,
+                 const uint64_t size,
+                 const uint64_t total)
+{
+    return offset <= total && size <= total - offset;
+}
+
+asset_archive::IndexEntry read_entry(const std::byte *index,
+                                     const std::size_t position)
+{
+    asset_archive::IndexEntry entry{};
+    std::memcpy(&entry,
+                index + position * sizeof(asset_archive::IndexEntry),
+                sizeof(entry));
+    return entry;
+}
+} // namespace
+
+bool AssetArchive::open(const std::filesystem::path &path)
+{
+    close();
+    if (!_file.open_read_only(path))
+    {
+        return false;
+    }
+
+    const auto fail{[this, &path](const char *reason)
+                    {
+                        spdlog::error("{} is not a valid asset archive: {}",
+                                      path.string(),
+                                      reason);
+                        _file.close();
+                        return false;
+                    }};
+    const uint64_t file_size{_file.size()};
+    if (file_size < asset_archive::kHeaderSize)
+    {
+        return fail("too small");
+    }
+
+    // Copy the header and entries out rather than aliasing the mapping
+    asset_archive::FileHeader header{};
+    std::memcpy(&header, _file.data(), sizeof(header));
+    if (header.magic != asset_archive::kMagic)
+    {
+        return fail("bad magic");
+    }
+    if (header.version != asset_archive::kVersion)
+    {
+        return fail("unsupported version");
+    }
+    if (!fits_within(header.index_offset,
+                     uint64_t{header.entry_count} *
+                         sizeof(asset_archive::IndexEntry),
+                     file_size) ||
+        !fits_within(header.names_offset, header.names_size, file_size))
+    {
+        return fail("truncated index");
+    }
+
+    _asset_count = header.entry_count;
+    _index_offset = header.index_offset;
+    _names_offset = header.names_offset;
+    std::string_view previous_name{};
+    for (std::size_t position{0}; position < _asset_count; ++position)
+    {
+        const asset_archive::IndexEntry entry{
+            read_entry(_file.data() + _index_offset, position)};
+        if (!fits_within(
+                entry.name_offset, entry.name_length, header.names_size) ||
+            !fits_within(entry.offset, entry.size, file_size) ||
+            entry.offset % asset_archive::kAlignment != 0)
+        {
+            return fail("entry out of range");
+        }
+        // Lookups are binary searches, so the index must stay sorted
+        const std::string_view current_name{name(position)};
+        if (position > 0 && !(previous_name < current_name))
+        {
+            return fail("index not sorted");
+        }
+        previous_name = current_name;
+    }
+    spdlog::debug("Opened asset archive {} with {} assets",
+                  path.string(),
+                  _asset_count);
+    return true;
+}
+
+void AssetArchive::close()
+{
+    _file.close();
+    _asset_count = 0;
+    _index_offset = 0;
+    _names_offset = 0;
+}
+
+bool AssetArchive::is_open() const
+{
+    return _file.is_open();
+}
+
+std::size_t AssetArchive::asset_count() const
+{
+    return _asset_count;
+}
+
+bool AssetArchive::find(const std::string_view name, AssetView &asset) const
+{
+    std::size_t first{0};
+    std::size_t last{_asset_count};
+    while (first < last)
+    {
+        const std::size_t middle{first + (last - first) / 2};
+        const std::string_view middle_name{this->name(middle)};
+        if (middle_name < name)
+        {
+            first = middle + 1;
+        }
+        else if (name < middle_name)
+        {
+            last = middle;
+        }
+        else
+        {
+            asset = view(middle);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string_view AssetArchive::name(const std::size_t index) const
+{
+    const asset_archive::IndexEntry entry{
+        read_entry(_file.data() + _index_offset, index)};
+    return std::string_view{
+        reinterpret_cast<const char *>( // NOLINT
+            _file.data() + _names_offset + entry.name_offset),
+        entry.name_length};
+}
+
+AssetView AssetArchive::view(const std::size_t index) const
+{
+    const asset_archive::IndexEntry entry{
+        read_entry(_file.data() + _index_offset, index)};
+    return AssetView{reinterpret_cast<const unsigned char *>( // NOLINT
+                         _file.data() + entry.offset),
+                     static_cast<std::size_t>(entry.size)};
+}
+
+bool pack_asset_archive(const std::filesystem::path &directory,
+                        const std::filesystem::path &output)
+{
+    std::error_code error{};
+    std::vector<PackedFile> files{};
+    for (const auto &item :
+         std::filesystem::recursive_directory_iterator{directory, error})
+    {
+        if (item.is_regular_file())
+        {
+            files.push_back(PackedFile{
+                item.path(),
+                std::filesystem::relative(item.path(), directory)
+                    .generic_string(),
+                static_cast<uint64_t>(item.file_size())});
+        }
+    }
+    if (error)
+    {
+        spdlog::error("Unable to list {}: {}", directory.string(), error.message());
+        return false;
+    }
+    std::sort(files.begin(),
+              files.end(),
+              [](const PackedFile &lhs, const PackedFile &rhs)
+              { return lhs.name < rhs.name; });
+
+    // Lay the whole file out before writing any of it
+    asset_archive::FileHeader header{asset_archive::kMagic,
+                                     asset_archive::kVersion,
+                                     static_cast<uint32_t>(files.size()),
+                                     asset_archive::kHeaderSize,
+                                     0,
+                                     0};
+    header.names_offset = header.index_offset +
+                          files.size() * sizeof(asset_archive::IndexEntry);
+    std::vector<asset_archive::IndexEntry> index{};
+    index.reserve(files.size());
+    std::string names{};
+    for (const PackedFile &file : files)
+    {
+        index.push_back(
+            asset_archive::IndexEntry{0,
+                                      file.size,
+                                      static_cast<uint32_t>(names.size()),
+                                      static_cast<uint32_t>(file.name.size())});
+        names += file.name;
+    }
+    header.names_size = names.size();
+    uint64_t offset{header.names_offset + header.names_size};
+    for (asset_archive::IndexEntry &entry : index)
+    {
+        entry.offset = align_up(offset);
+        offset = entry.offset + entry.size;
+    }
+
+    std::filesystem::path temporary{output};
+    temporary += ".tmp";
+    {
+        std::ofstream stream{temporary, std::ios::binary | std::ios::trunc};
+        if (!stream)
+        {
+            spdlog::error("Unable to write {}", temporary.string());
+            return false;
+        }
+        stream.write(reinterpret_cast<const char *>(&header), // NOLINT
+                     sizeof(header));
+        write_padding(stream, header.index_offset);
+        stream.write(reinterpret_cast<const char *>(index.data()), // NOLINT
+                     static_cast<std::streamsize>(
+                         index.size() * sizeof(asset_archive::IndexEntry)));
+        stream.write(names.data(), static_cast<std::streamsize>(names.size()));
+        for (std::size_t position{0}; position < files.size(); ++position)
+        {
+            write_padding(stream, index.at(position).offset);
+            if (index.at(position).size == 0)
+            {
+                continue;
+            }
+            // Inserting an empty buffer would set failbit, hence the skip
+            std::ifstream input{files.at(position).path, std::ios::binary};
+            stream << input.rdbuf();
+            if (!input ||
+                static_cast<uint64_t>(stream.tellp()) !=
+                    index.at(position).offset + index.at(position).size)
+            {
+                spdlog::error("Unable to pack {}",
+                              files.at(position).path.string());
+                return false;
+            }
+        }
+        if (!stream)
+        {
+            spdlog::error("Unable to write {}", temporary.string());
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, output, error);
+    if (error)
+    {
+        spdlog::error("Unable to replace {}: {}", output.string(), error.message());
+        return false;
+    }
+    spdlog::info("Packed {} assets, {} bytes, into {}",
+                 files.size(),
+                 offset,
+                 output.string());
+    return true;
+}
@@ -0,0 +1,51 @@
+#ifndef SRC_ASSETS_ASSET_ARCHIVE_H
+#define SRC_ASSETS_ASSET_ARCHIVE_H
+
+#include "platform/mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+// An asset's bytes inside the mapped archive. Only valid while the archive
+// stays open.
+struct AssetView
+{
+    const unsigned char *data{nullptr};
+    std::size_t size{0};
+};
+
+// Read-only access to an archive written by pack_asset_archive. The whole
+// file is memory-mapped, and lookups return views into the mapping, so
+// loaders such as LoadFontFromMemory read straight from the page cache
+// without an intermediate copy.
+class AssetArchive
+{
+public:
+    // Maps and validates the archive. Failures are logged and leave it closed.
+    bool open(const std::filesystem::path &path);
+    void close();
+
+    [[nodiscard]] bool is_open() const;
+    [[nodiscard]] std::size_t asset_count() const;
+    // Binary search of the sorted index, by path relative to the packed
+    // directory such as "fonts/body.ttf"
+    bool find(std::string_view name, AssetView &asset) const;
+
+private:
+    [[nodiscard]] std::string_view name(std::size_t index) const;
+    [[nodiscard]] AssetView view(std::size_t index) const;
+
+    MappedFile _file{};
+    std::size_t _asset_count{0};
+    uint64_t _index_offset{0};
+    uint64_t _names_offset{0};
+};
+
+// Packs every regular file below directory into an archive at output,
+// replacing it only once the new archive is complete. Failures are logged.
+bool pack_asset_archive(const std::filesystem::path &directory,
+                        const std::filesystem::path &output);
+
+#endif
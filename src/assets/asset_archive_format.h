@@ -0,0 +1,47 @@
+#ifndef SRC_ASSETS_ASSET_ARCHIVE_FORMAT_H
+#define SRC_ASSETS_ASSET_ARCHIVE_FORMAT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// On-disk layout of a packed asset archive, shared by the packer and the
+// runtime reader. The file is a FileHeader, then entry_count IndexEntry
+// records sorted by name, then the names table, then each asset's bytes
+// starting on a kAlignment boundary. Names are paths relative to the packed
+// directory with forward slashes, stored without terminators. Fields are
+// little endian, native layout.
+namespace asset_archive
+{
+constexpr std::array<char, 8> kMagic{'J', 'R', 'A', 'S', 'S', 'E', 'T', 'S'};
+constexpr uint32_t kVersion{1};
+// Asset data starts on a cache line, so it can be handed straight to loaders
+// that expect aligned buffers
+constexpr std::size_t kAlignment{64};
+
+struct FileHeader
+{
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint64_t index_offset;
+    uint64_t names_offset;
+    uint64_t names_size;
+};
+
+struct IndexEntry
+{
+    uint64_t offset;
+    uint64_t size;
+    uint32_t name_offset; // into the names table
+    uint32_t name_length;
+};
+
+// The index starts on a cache line
+constexpr std::size_t kHeaderSize{64};
+
+static_assert(sizeof(FileHeader) <= kHeaderSize);
+static_assert(sizeof(IndexEntry) == 24);
+} // namespace asset_archive
+
+#endif
@@ -0,0 +1,65 @@
+#include "command_line.h"
+
+#include "game/frame_capture.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+CommandLineOptions parse_command_line(int argc, char **argv)
+{
+    CommandLineOptions options{};
+    // argv[0] is the program name
+    const std::vector<std::string_view> arguments(
+        argv + (argc > 0 ? 1 : 0), // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+        argv + argc); // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+
+    for (std::size_t index{0}; index < arguments.size(); ++index)
+    {
+        const std::string_view argument{arguments[index]};
+        const bool has_value{index + 1 < arguments.size()};
+        if (argument == "--capture-format" && has_value)
+        {
+            const std::string_view value{arguments[++index]};
+            if (value == "png")
+            {
+                options.capture_format = CaptureFormat::PNG;
+            }
+            else if (value == "y4m")
+            {
+                options.capture_format = CaptureFormat::Y4M;
+            }
+            else
+            {
+                spdlog::warn("Unknown capture format: {}", value);
+            }
+        }
+        else if (argument == "--capture-directory" && has_value)
+        {
+            options.capture_directory = arguments[++index];
+        }
+        else if (argument == "--flight-recorder" && has_value)
+        {
+            options.flight_recorder = arguments[++index];
+        }
+        else if (argument == "--scene" && has_value)
+        {
+            options.scene = arguments[++index];
+        }
+        else if (argument == "--tuning" && has_value)
+        {
+            options.tuning = arguments[++index];
+        }
+        else if (argument == "--steady-state")
+        {
+            options.steady_state = true;
+        }
+        else
+        {
+            spdlog::warn("Ignoring unknown option: {}", argument);
+        }
+    }
+    return options;
+}
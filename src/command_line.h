@@ -0,0 +1,25 @@
+#ifndef SRC_COMMAND_LINE_H
+#define SRC_COMMAND_LINE_H
+
+#include "game/frame_capture.h"
+
+#include <filesystem>
+
+struct CommandLineOptions
+{
+    CaptureFormat capture_format{CaptureFormat::PNG};
+    std::filesystem::path capture_directory{"captures"};
+    // Warn about any frame that allocates once the app has warmed up
+    bool steady_state{false};
+    // Body states are recorded to this file when it is set
+    std::filesystem::path flight_recorder{};
+    // Scene file to load instead of the built-in hello world scene
+    std::filesystem::path scene{};
+    // Tuning file to read instead of the built-in defaults
+    std::filesystem::path tuning{};
+};
+
+// Unknown or malformed options are reported and otherwise ignored
+CommandLineOptions parse_command_line(int argc, char **argv);
+
+#endif
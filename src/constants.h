@@ -18,6 +18,16 @@ inline constexpr float kCameraPositionY{10.F};
 inline constexpr float kCameraPositionZ{10.F};
 inline constexpr float kCameraFovY{45.F};
 inline constexpr float kBallRadius{0.5F};
+inline constexpr float kBallInitialPositionY{10.F};
+inline constexpr float kBallInitialVelocityX{0.5F};
+// E sets off an explosion this far below the ball
+inline constexpr float kExplosionDepth{1.F};
+inline constexpr float kExplosionRadius{4.F};
+inline constexpr float kExplosionStrength{3'000.F};
+inline constexpr float kFloorPositionY{-1.F};
+inline constexpr float kFloorHalfExtentX{5.F};
+inline constexpr float kFloorHalfExtentY{1.F};
+inline constexpr float kFloorHalfExtentZ{5.F};
 inline constexpr int kGridSlices{10};
 inline constexpr float kCubeSpeed{1.2F};
 inline constexpr float kCubePositionMinZ{-5.F};
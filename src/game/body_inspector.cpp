@@ -0,0 +1,253 @@
+#include "body_inspector.h"
+
+#include "physics/physics.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Body/MotionType.h>
+#include <imgui.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace
+{
+enum class Column : ImGuiID
+{
+    ID,
+    Layer,
+    Motion,
+    Position,
+    Velocity,
+    Sleep
+};
+
+constexpr int kColumnCount{6};
+constexpr float kRowsShown{20.F};
+// Spawners change the body count almost every frame, so a count change alone
+// only rebuilds the rows this often. Removed bodies show as removed until then.
+constexpr std::chrono::milliseconds kCountRebuildInterval{500};
+
+const char *layer_name(const JPH::ObjectLayer layer)
+{
+    switch (layer)
+    {
+    case Layers::NON_MOVING:
+        return "NON_MOVING";
+    case Layers::MOVING:
+        return "MOVING";
+    default:
+        return "?";
+    }
+}
+
+const char *motion_type_name(const JPH::EMotionType motion_type)
+{
+    switch (motion_type)
+    {
+    case JPH::EMotionType::Static:
+        return "Static";
+    case JPH::EMotionType::Kinematic:
+        return "Kinematic";
+    case JPH::EMotionType::Dynamic:
+        return "Dynamic";
+    }
+    return "?";
+}
+
+// Position sorts by height and velocity by speed
+float sort_value(const Column column, const BodyState &state)
+{
+    switch (column)
+    {
+    case Column::ID:
+        return static_cast<float>(state.id.GetIndex());
+    case Column::Layer:
+        return static_cast<float>(state.layer);
+    case Column::Motion:
+        return static_cast<float>(state.motion_type);
+    case Column::Position:
+        return static_cast<float>(state.position.GetY());
+    case Column::Velocity:
+        return state.linear_velocity.Length();
+    case Column::Sleep:
+        return state.active ? 1.F : 0.F;
+    }
+    return 0.F;
+}
+
+float milliseconds_since(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<float, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+} // namespace
+
+void BodyInspector::draw(const PhysicsEngine &physics_engine)
+{
+    const auto start{std::chrono::steady_clock::now()};
+
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Body Inspector"))
+    {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text( // NOLINT [cppcoreguidelines-pro-type-vararg]
+        "%u bodies, %zu shown. Panel %.3f ms, last rebuild %.3f ms",
+        physics_engine.get_num_bodies(),
+        _rows.size(),
+        static_cast<double>(_last_draw_milliseconds),
+        static_cast<double>(_last_rebuild_milliseconds));
+
+    int layer_combo{_layer_filter + 1};
+    if (ImGui::Combo("Layer", &layer_combo, "All\0NON_MOVING\0MOVING\0\0"))
+    {
+        _layer_filter = layer_combo - 1;
+        _rows_dirty = true;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Refresh"))
+    {
+        _rows_dirty = true;
+    }
+
+    constexpr ImGuiTableFlags kTableFlags{
+        ImGuiTableFlags_Sortable | // NOLINT [hicpp-signed-bitwise]
+        ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg |
+        ImGuiTableFlags_BordersOuter | ImGuiTableFlags_Resizable};
+    const ImVec2 table_size{0.F, ImGui::GetTextLineHeightWithSpacing() *
+                                     kRowsShown};
+    if (ImGui::BeginTable("bodies", kColumnCount, kTableFlags, table_size))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("ID",
+                                ImGuiTableColumnFlags_DefaultSort,
+                                0.F,
+                                static_cast<ImGuiID>(Column::ID));
+        ImGui::TableSetupColumn(
+            "Layer", 0, 0.F, static_cast<ImGuiID>(Column::Layer));
+        ImGui::TableSetupColumn(
+            "Motion", 0, 0.F, static_cast<ImGuiID>(Column::Motion));
+        ImGui::TableSetupColumn(
+            "Position", 0, 0.F, static_cast<ImGuiID>(Column::Position));
+        ImGui::TableSetupColumn(
+            "Velocity", 0, 0.F, static_cast<ImGuiID>(Column::Velocity));
+        ImGui::TableSetupColumn(
+            "Sleep", 0, 0.F, static_cast<ImGuiID>(Column::Sleep));
+        ImGui::TableHeadersRow();
+
+        ImGuiTableSortSpecs *sort_specs{ImGui::TableGetSortSpecs()};
+        if (sort_specs != nullptr && sort_specs->SpecsDirty &&
+            sort_specs->SpecsCount > 0)
+        {
+            _sort_column = static_cast<int>(sort_specs->Specs->ColumnUserID);
+            _sort_ascending = sort_specs->Specs->SortDirection ==
+                              ImGuiSortDirection_Ascending;
+            sort_specs->SpecsDirty = false;
+            _rows_dirty = true;
+        }
+
+        const bool count_changed{physics_engine.get_num_bodies() !=
+                                 _body_ids.size()};
+        if (_rows_dirty ||
+            (count_changed && start - _last_rebuild >= kCountRebuildInterval))
+        {
+            rebuild_rows(physics_engine);
+        }
+
+        ImGuiListClipper clipper{};
+        clipper.Begin(static_cast<int>(_rows.size()));
+        while (clipper.Step())
+        {
+            for (int row_index{clipper.DisplayStart};
+                 row_index < clipper.DisplayEnd;
+                 ++row_index)
+            {
+                const Row &row{_rows.at(static_cast<std::size_t>(row_index))};
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", // NOLINT [cppcoreguidelines-pro-type-vararg]
+                            row.id.GetIndex());
+
+                BodyState state{};
+                if (!physics_engine.get_body_state(row.id, state))
+                {
+                    ImGui::TableNextColumn();
+                    ImGui::TextDisabled("removed"); // NOLINT
+                    continue;
+                }
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(layer_name(state.layer));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(motion_type_name(state.motion_type));
+                ImGui::TableNextColumn();
+                ImGui::Text( // NOLINT [cppcoreguidelines-pro-type-vararg]
+                    "%.2f, %.2f, %.2f",
+                    static_cast<double>(state.position.GetX()),
+                    static_cast<double>(state.position.GetY()),
+                    static_cast<double>(state.position.GetZ()));
+                ImGui::TableNextColumn();
+                ImGui::Text( // NOLINT [cppcoreguidelines-pro-type-vararg]
+                    "%.2f, %.2f, %.2f",
+                    static_cast<double>(state.linear_velocity.GetX()),
+                    static_cast<double>(state.linear_velocity.GetY()),
+                    static_cast<double>(state.linear_velocity.GetZ()));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(state.active ? "awake" : "asleep");
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+
+    _last_draw_milliseconds = milliseconds_since(start);
+}
+
+void BodyInspector::rebuild_rows(const PhysicsEngine &physics_engine)
+{
+    const auto start{std::chrono::steady_clock::now()};
+
+    // Both vectors keep their capacity, so rebuilding only allocates when the
+    // world has grown
+    physics_engine.get_body_ids(_body_ids);
+    _rows.clear();
+    _rows.reserve(_body_ids.size());
+
+    const auto column{static_cast<Column>(_sort_column)};
+    for (const JPH::BodyID &body_id : _body_ids)
+    {
+        BodyState state{};
+        if (!physics_engine.get_body_state(body_id, state))
+        {
+            continue;
+        }
+        if (_layer_filter >= 0 &&
+            state.layer != static_cast<JPH::ObjectLayer>(_layer_filter))
+        {
+            continue;
+        }
+        _rows.push_back(Row{body_id, sort_value(column, state)});
+    }
+
+    const bool ascending{_sort_ascending};
+    std::sort(_rows.begin(),
+              _rows.end(),
+              [ascending](const Row &lhs, const Row &rhs)
+              {
+                  if (lhs.sort_value != rhs.sort_value)
+                  {
+                      return ascending ? lhs.sort_value < rhs.sort_value
+                                       : lhs.sort_value > rhs.sort_value;
+                  }
+                  return lhs.id < rhs.id;
+              });
+
+    _rows_dirty = false;
+    _last_rebuild = start;
+    _last_rebuild_milliseconds = milliseconds_since(start);
+}
@@ -0,0 +1,95 @@
+#include "dynamic_resolution.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace
+{
+// Frames above budget by more than this fraction count as over budget. The
+// frame limiter keeps frame times hovering just around the budget, so
+// within-budget allows a little jitter.
+constexpr float kOverBudget{1.1F};
+constexpr float kWithinBudget{1.02F};
+constexpr std::size_t kPercentileIndex{DynamicResolution::kWindowSize * 9 /
+                                       10};
+constexpr std::size_t kMaxUpscaleBackoff{16};
+} // namespace
+
+DynamicResolution::DynamicResolution(const float frame_budget)
+    : _frame_budget{frame_budget}
+{
+}
+
+bool DynamicResolution::add_frame_time(const float frame_time)
+{
+    _frame_times.at(_next_sample) = frame_time;
+    _next_sample = (_next_sample + 1) % kWindowSize;
+    ++_samples_since_change;
+
+    // Only judge a level once a full window of frames has been rendered at it
+    if (_samples_since_change < kWindowSize)
+    {
+        return false;
+    }
+
+    _scratch = _frame_times;
+    const auto percentile{_scratch.begin() +
+                          static_cast<std::ptrdiff_t>(kPercentileIndex)};
+    std::nth_element(_scratch.begin(), percentile, _scratch.end());
+    _percentile_frame_time = *percentile;
+
+    if (_percentile_frame_time > _frame_budget * kOverBudget)
+    {
+        if (_level + 1 >= kResolutionScales.size())
+        {
+            return false;
+        }
+        if (_last_change_was_upscale &&
+            _samples_since_change == kWindowSize)
+        {
+            _upscale_backoff =
+                std::min(_upscale_backoff * 2, kMaxUpscaleBackoff);
+        }
+        change_level(_level + 1);
+        _last_change_was_upscale = false;
+        return true;
+    }
+
+    if (_percentile_frame_time <= _frame_budget * kWithinBudget)
+    {
+        if (_last_change_was_upscale)
+        {
+            // The last climb held, so go back to climbing eagerly
+            _upscale_backoff = 1;
+        }
+        if (_level > 0 &&
+            _samples_since_change >= kWindowSize * _upscale_backoff)
+        {
+            change_level(_level - 1);
+            _last_change_was_upscale = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t DynamicResolution::level() const
+{
+    return _level;
+}
+
+float DynamicResolution::scale() const
+{
+    return kResolutionScales.at(_level);
+}
+
+float DynamicResolution::percentile_frame_time() const
+{
+    return _percentile_frame_time;
+}
+
+void DynamicResolution::change_level(const std::size_t level)
+{
+    _level = level;
+    _samples_since_change = 0;
+}
@@ -0,0 +1,48 @@
+#ifndef SRC_GAME_DYNAMIC_RESOLUTION_H
+#define SRC_GAME_DYNAMIC_RESOLUTION_H
+
+#include <array>
+#include <cstddef>
+
+// Internal resolution scales the controller can pick from, full resolution
+// first. Render textures are pooled per level, so switching never allocates.
+inline constexpr std::array<float, 5> kResolutionScales{1.F,
+                                                        0.875F,
+                                                        0.75F,
+                                                        0.625F,
+                                                        0.5F};
+
+// Feedback controller choosing the internal resolution level from a high
+// percentile of recent frame times. It drops a level as soon as a full window
+// of frames runs over budget, and only climbs back when a window is within
+// budget. A climb that immediately has to be undone doubles the wait before the
+// next attempt, which stops the controller oscillating between two levels.
+class DynamicResolution
+{
+public:
+    static constexpr std::size_t kWindowSize{60};
+
+    explicit DynamicResolution(float frame_budget);
+
+    // Returns true when the resolution level changed
+    bool add_frame_time(float frame_time);
+
+    [[nodiscard]] std::size_t level() const;
+    [[nodiscard]] float scale() const;
+    [[nodiscard]] float percentile_frame_time() const;
+
+private:
+    void change_level(std::size_t level);
+
+    float _frame_budget;
+    std::array<float, kWindowSize> _frame_times{};
+    std::array<float, kWindowSize> _scratch{};
+    std::size_t _next_sample{0};
+    std::size_t _samples_since_change{0};
+    std::size_t _level{0};
+    std::size_t _upscale_backoff{1};
+    bool _last_change_was_upscale{false};
+    float _percentile_frame_time{0.F};
+};
+
+#endif
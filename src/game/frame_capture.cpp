@@ -0,0 +1,303 @@
+#include "frame_capture.h"
+
+#include "constants.h"
+#include "framebuffer_readback.h"
+
+#include <fmt/core.h>
+#include <raylib.h>
+#include <rlgl.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ios>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace
+{
+constexpr std::size_t kBytesPerPixel{4};
+
+// BT.601 limited range RGB to YCbCr, in 8.8 fixed point
+unsigned char luma(int red, int green, int blue)
+{
+    constexpr int kRed{66};
+    constexpr int kGreen{129};
+    constexpr int kBlue{25};
+    constexpr int kRound{128};
+    constexpr int kOffset{16};
+    return static_cast<unsigned char>(
+        ((kRed * red + kGreen * green + kBlue * blue + kRound) >> 8) +
+        kOffset);
+}
+
+unsigned char chroma_blue(int red, int green, int blue)
+{
+    constexpr int kRed{-38};
+    constexpr int kGreen{-74};
+    constexpr int kBlue{112};
+    constexpr int kRound{128};
+    constexpr int kOffset{128};
+    return static_cast<unsigned char>(
+        ((kRed * red + kGreen * green + kBlue * blue + kRound) >> 8) +
+        kOffset);
+}
+
+unsigned char chroma_red(int red, int green, int blue)
+{
+    constexpr int kRed{112};
+    constexpr int kGreen{-94};
+    constexpr int kBlue{-18};
+    constexpr int kRound{128};
+    constexpr int kOffset{128};
+    return static_cast<unsigned char>(
+        ((kRed * red + kGreen * green + kBlue * blue + kRound) >> 8) +
+        kOffset);
+}
+} // namespace
+
+FrameCapture::~FrameCapture()
+{
+    stop();
+}
+
+bool FrameCapture::start(const std::filesystem::path &directory,
+                         const CaptureFormat format,
+                         const int width,
+                         const int height)
+{
+    if (_capturing)
+    {
+        return true;
+    }
+
+    std::error_code error{};
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        spdlog::error("Not capturing frames, could not create {}: {}",
+                      directory.string(),
+                      error.message());
+        return false;
+    }
+    if (format == CaptureFormat::Y4M)
+    {
+        _y4m_stream.open(directory / "capture.y4m",
+                         std::ios::binary | std::ios::trunc);
+        if (!_y4m_stream)
+        {
+            spdlog::error("Not capturing frames, could not open {}",
+                          (directory / "capture.y4m").string());
+            _y4m_stream.close();
+            _y4m_stream.clear();
+            return false;
+        }
+    }
+
+    _directory = directory;
+    _format = format;
+    _width = width;
+    _height = height;
+
+    // All frame memory is allocated here, so capturing a frame never allocates
+    const std::size_t frame_bytes{static_cast<std::size_t>(width) *
+                                  static_cast<std::size_t>(height) *
+                                  kBytesPerPixel};
+    _slots.resize(kRingSize);
+    for (Slot &slot : _slots)
+    {
+        slot.pixels.resize(frame_bytes);
+    }
+
+    if (_format == CaptureFormat::Y4M)
+    {
+        _y4m_planes.resize(static_cast<std::size_t>(width) *
+                           static_cast<std::size_t>(height) * 3);
+        _y4m_stream << fmt::format("YUV4MPEG2 W{} H{} F{}:1 Ip A1:1 C444\n",
+                                   width,
+                                   height,
+                                   constants::kTargetFramerate);
+    }
+
+    _read_slot = 0;
+    _write_slot = 0;
+    _filled_slots = 0;
+    _stopping = false;
+    _next_frame = 0;
+    _frames_written = 0;
+    _frames_dropped = 0;
+    _capturing = true;
+    _encoder = std::thread{&FrameCapture::encode_loop, this};
+    spdlog::info("Capturing frames to {}", _directory.string());
+    return true;
+}
+
+void FrameCapture::stop()
+{
+    if (!_capturing)
+    {
+        return;
+    }
+    {
+        const std::lock_guard<std::mutex> lock{_mutex};
+        _stopping = true;
+    }
+    _frame_ready.notify_one();
+    _encoder.join();
+    _capturing = false;
+
+    if (_y4m_stream.is_open())
+    {
+        _y4m_stream.close();
+    }
+    spdlog::info("Frame capture stopped: {} frames written, {} dropped",
+                 _frames_written.load(),
+                 _frames_dropped.load());
+}
+
+void FrameCapture::capture(const RenderTexture &texture)
+{
+    if (!_capturing)
+    {
+        return;
+    }
+
+    Slot *slot{nullptr};
+    {
+        const std::lock_guard<std::mutex> lock{_mutex};
+        if (_filled_slots == _slots.size())
+        {
+            ++_frames_dropped;
+            ++_next_frame;
+            return;
+        }
+        slot = &_slots.at(_write_slot);
+    }
+
+    // The encoder never touches a slot until it is marked as filled, so the
+    // read back can happen outside the lock. It goes straight into the slot,
+    // so capturing a frame never allocates.
+    rlEnableFramebuffer(texture.id);
+    read_bound_framebuffer(
+        texture.texture.width, texture.texture.height, slot->pixels.data());
+    rlDisableFramebuffer();
+    slot->frame = _next_frame++;
+
+    {
+        const std::lock_guard<std::mutex> lock{_mutex};
+        _write_slot = (_write_slot + 1) % _slots.size();
+        ++_filled_slots;
+    }
+    _frame_ready.notify_one();
+}
+
+bool FrameCapture::capturing() const
+{
+    return _capturing;
+}
+
+uint64_t FrameCapture::frames_written() const
+{
+    return _frames_written.load();
+}
+
+uint64_t FrameCapture::frames_dropped() const
+{
+    return _frames_dropped.load();
+}
+
+void FrameCapture::encode_loop()
+{
+    for (;;)
+    {
+        Slot *slot{nullptr};
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _frame_ready.wait(lock,
+                              [this]() { return _filled_slots > 0 || _stopping; });
+            if (_filled_slots == 0)
+            {
+                return;
+            }
+            slot = &_slots.at(_read_slot);
+        }
+
+        if (_format == CaptureFormat::PNG)
+        {
+            encode_png(*slot);
+        }
+        else
+        {
+            encode_y4m(*slot);
+        }
+        ++_frames_written;
+
+        {
+            const std::lock_guard<std::mutex> lock{_mutex};
+            _read_slot = (_read_slot + 1) % _slots.size();
+            --_filled_slots;
+        }
+    }
+}
+
+void FrameCapture::encode_png(Slot &slot) const
+{
+    // Render textures are stored bottom up, flip in place before writing
+    const std::size_t row_bytes{static_cast<std::size_t>(_width) *
+                                kBytesPerPixel};
+    const auto rows{static_cast<std::size_t>(_height)};
+    unsigned char *data{slot.pixels.data()};
+    for (std::size_t row{0}; row < rows / 2; ++row)
+    {
+        std::swap_ranges(data + row * row_bytes,
+                         data + (row + 1) * row_bytes,
+                         data + (rows - row - 1) * row_bytes);
+    }
+
+    const Image image{data,
+                      _width,
+                      _height,
+                      1,
+                      PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+    const std::string path{
+        (_directory / fmt::format("frame_{:06d}.png", slot.frame)).string()};
+    ExportImage(image, path.c_str());
+}
+
+void FrameCapture::encode_y4m(const Slot &slot)
+{
+    const auto width{static_cast<std::size_t>(_width)};
+    const auto height{static_cast<std::size_t>(_height)};
+    const std::size_t plane_size{width * height};
+    unsigned char *luma_plane{_y4m_planes.data()};
+    unsigned char *blue_plane{luma_plane + plane_size};
+    unsigned char *red_plane{blue_plane + plane_size};
+
+    for (std::size_t row{0}; row < height; ++row)
+    {
+        // Bottom up source, top down output
+        const unsigned char *source{slot.pixels.data() +
+                                    (height - row - 1) * width *
+                                        kBytesPerPixel};
+        for (std::size_t column{0}; column < width; ++column)
+        {
+            const unsigned char *pixel{source + column * kBytesPerPixel};
+            const int red{pixel[0]};
+            const int green{pixel[1]};
+            const int blue{pixel[2]};
+            const std::size_t index{row * width + column};
+            luma_plane[index] = luma(red, green, blue);
+            blue_plane[index] = chroma_blue(red, green, blue);
+            red_plane[index] = chroma_red(red, green, blue);
+        }
+    }
+
+    _y4m_stream << "FRAME\n";
+    _y4m_stream.write(reinterpret_cast<const char *>( // NOLINT
+                          _y4m_planes.data()),
+                      static_cast<std::streamsize>(_y4m_planes.size()));
+}
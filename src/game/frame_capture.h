@@ -0,0 +1,87 @@
+#ifndef SRC_GAME_FRAME_CAPTURE_H
+#define SRC_GAME_FRAME_CAPTURE_H
+
+#include <raylib.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum class CaptureFormat : uint8_t
+{
+    PNG, // one numbered PNG per frame
+    Y4M  // a single raw YUV 4:4:4 stream
+};
+
+// Captures rendered frames to disk without stalling the main loop on I/O. The
+// main thread reads each frame back into one of a ring of preallocated
+// buffers and a background thread encodes and writes them. When the encoder
+// falls behind and the ring is full, frames are dropped and counted rather
+// than waited for.
+class FrameCapture
+{
+public:
+    static constexpr std::size_t kRingSize{8};
+
+    FrameCapture() = default;
+    FrameCapture(const FrameCapture &) = delete;
+    FrameCapture &operator=(const FrameCapture &) = delete;
+    FrameCapture(FrameCapture &&) = delete;
+    FrameCapture &operator=(FrameCapture &&) = delete;
+    ~FrameCapture();
+
+    // Returns false, and logs why, when the output cannot be created
+    [[nodiscard]] bool start(const std::filesystem::path &directory,
+                             CaptureFormat format,
+                             int width,
+                             int height);
+    // Encodes any frames still queued, then stops the encoder thread
+    void stop();
+
+    // Main thread only. The texture must match the size passed to start.
+    void capture(const RenderTexture &texture);
+
+    [[nodiscard]] bool capturing() const;
+    [[nodiscard]] uint64_t frames_written() const;
+    [[nodiscard]] uint64_t frames_dropped() const;
+
+private:
+    struct Slot
+    {
+        std::vector<unsigned char> pixels{};
+        uint64_t frame{0};
+    };
+
+    void encode_loop();
+    void encode_png(Slot &slot) const;
+    void encode_y4m(const Slot &slot);
+
+    std::filesystem::path _directory{};
+    CaptureFormat _format{CaptureFormat::PNG};
+    int _width{0};
+    int _height{0};
+    std::vector<Slot> _slots{};
+    std::vector<unsigned char> _y4m_planes{};
+    std::ofstream _y4m_stream{};
+
+    std::thread _encoder{};
+    std::mutex _mutex{};
+    std::condition_variable _frame_ready{};
+    std::size_t _read_slot{0};
+    std::size_t _write_slot{0};
+    std::size_t _filled_slots{0};
+    bool _stopping{false};
+    bool _capturing{false};
+
+    uint64_t _next_frame{0};
+    std::atomic<uint64_t> _frames_written{0};
+    std::atomic<uint64_t> _frames_dropped{0};
+};
+
+#endif
@@ -0,0 +1,19 @@
+#include "framebuffer_readback.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+void read_bound_framebuffer(const int width,
+                            const int height,
+                            unsigned char *pixels)
+{
+    // Rows are tightly packed, whatever the width
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+}
@@ -0,0 +1,10 @@
+#ifndef SRC_GAME_FRAMEBUFFER_READBACK_H
+#define SRC_GAME_FRAMEBUFFER_READBACK_H
+
+// Copies the bound framebuffer's RGBA8 pixels, bottom row first, into pixels,
+// which must hold width * height * 4 bytes. Unlike rlReadTexturePixels it
+// never allocates. Kept apart from raylib because the system OpenGL header
+// clashes with raylib.h on Windows.
+void read_bound_framebuffer(int width, int height, unsigned char *pixels);
+
+#endif
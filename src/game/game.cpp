@@ -1,55 +1,195 @@
 #include "game.h"
 
 #include "constants.h"
+#include "physics/physics.h"
+#include "scene/spawner_system.h"
 
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Physics/PhysicsSettings.h>
 #include <fmt/core.h>
 #include <imgui.h>
 #include <raylib.h>
 
-#include <queue>
+#include <array>
+#include <cfloat>
+#include <cstddef>
 #include <string>
 
-void draw_scene(const Camera &camera,
-                const Vector3 &ball_position,
-                const Color &ball_colour,
-                const Font &font)
+namespace
+{
+void plot_history(const char *label,
+                  const std::array<float, StepStatsHistory::kLength> &values,
+                  const std::size_t next,
+                  const char *unit)
 {
-    BeginMode3D(camera);
-    DrawSphere(ball_position, constants::kBallRadius, ball_colour);
-    DrawGrid(constants::kGridSlices, constants::kGridSpacing);
-    EndMode3D();
-    const float kDefaultFontSize{10.F};
-    DrawTextEx(font,
-               "Press F9 for ImGui debug mode",
-               Vector2{constants::kTextPositionX, constants::kTextPositionY},
-               static_cast<float>(constants::kTextFontSize),
-               static_cast<float>(constants::kTextFontSize) / kDefaultFontSize,
-               DARKGRAY);
-    DrawFPS(constants::kFPSPositionX, constants::kFPSPositionY);
+    constexpr float kGraphHeight{40.F};
+    const std::size_t latest{(next + StepStatsHistory::kLength - 1) %
+                             StepStatsHistory::kLength};
+    std::array<char, 32> overlay{};
+    fmt::format_to_n(overlay.data(),
+                     overlay.size() - 1,
+                     "{:.4f} {}",
+                     values.at(latest),
+                     unit);
+    ImGui::PlotLines(label,
+                     values.data(),
+                     static_cast<int>(values.size()),
+                     static_cast<int>(next),
+                     overlay.data(),
+                     FLT_MAX,
+                     FLT_MAX,
+                     ImVec2{0.F, kGraphHeight});
+}
+
+// Edits the solver settings in place, applying them to the live physics system
+// as soon as any control changes, with the cost and accuracy graphs alongside
+void draw_physics_settings(PhysicsEngine &physics_engine)
+{
+    JPH::PhysicsSettings settings{physics_engine.get_physics_settings()};
+    bool changed{false};
+
+    constexpr int kMaxVelocitySteps{30};
+    constexpr int kMaxPositionSteps{10};
+    constexpr float kMaxDistance{0.1F};
+    constexpr float kMaxTimeBeforeSleep{5.F};
+    constexpr float kMaxSleepThreshold{0.5F};
+
+    int velocity_steps{static_cast<int>(settings.mNumVelocitySteps)};
+    if (ImGui::SliderInt("Velocity steps", &velocity_steps, 1, kMaxVelocitySteps))
+    {
+        settings.mNumVelocitySteps = static_cast<JPH::uint>(velocity_steps);
+        changed = true;
+    }
+    int position_steps{static_cast<int>(settings.mNumPositionSteps)};
+    if (ImGui::SliderInt("Position steps", &position_steps, 0, kMaxPositionSteps))
+    {
+        settings.mNumPositionSteps = static_cast<JPH::uint>(position_steps);
+        changed = true;
+    }
+    changed |= ImGui::SliderFloat("Baumgarte", &settings.mBaumgarte, 0.F, 1.F);
+    changed |= ImGui::SliderFloat("Speculative contact distance",
+                                  &settings.mSpeculativeContactDistance,
+                                  0.F,
+                                  kMaxDistance);
+    changed |= ImGui::SliderFloat(
+        "Penetration slop", &settings.mPenetrationSlop, 0.F, kMaxDistance);
+    changed |= ImGui::Checkbox("Allow sleeping", &settings.mAllowSleeping);
+    changed |= ImGui::SliderFloat("Time before sleep",
+                                  &settings.mTimeBeforeSleep,
+                                  0.F,
+                                  kMaxTimeBeforeSleep);
+    changed |= ImGui::SliderFloat("Sleep velocity threshold",
+                                  &settings.mPointVelocitySleepThreshold,
+                                  0.F,
+                                  kMaxSleepThreshold);
+    if (ImGui::Button("Reset to defaults"))
+    {
+        settings = JPH::PhysicsSettings{};
+        changed = true;
+    }
+    if (changed)
+    {
+        physics_engine.set_physics_settings(settings);
+    }
+
+    const StepStatsHistory &history{physics_engine.get_step_stats_history()};
+    plot_history("Step time", history.step_milliseconds, history.next, "ms");
+    plot_history(
+        "Max penetration", history.max_penetration, history.next, "m");
+    plot_history("Energy change", history.energy_change, history.next, "/step");
 }
+} // namespace
 
-void Game_Update(std::queue<int> *key_queue, bool *debug_menu)
+void Game_Update(InputRing *input_ring,
+                 LatencyTracker *latency_tracker,
+                 bool *debug_menu,
+                 bool *capture_frames,
+                 bool *kick_ball,
+                 bool *explode)
 {
-    for (; !key_queue->empty(); key_queue->pop())
+    const LatencyTracker::Clock::time_point tick_time{
+        LatencyTracker::Clock::now()};
+    InputEvent event{};
+    while (input_ring->pop(event))
     {
-        const int key{key_queue->front()};
-        if (key == 0)
+        if (event.key == KEY_F9)
         {
-            continue;
+            *(debug_menu) = !(*debug_menu);
+            latency_tracker->begin(event.timestamp, tick_time, false);
         }
-        if (key == KEY_F9)
+        else if (event.key == KEY_F10)
         {
-            *(debug_menu) = !(*debug_menu);
+            *(capture_frames) = !(*capture_frames);
+        }
+        else if (event.key == KEY_SPACE)
+        {
+            // The kick only shows once the physics step has moved the ball
+            *(kick_ball) = true;
+            latency_tracker->begin(event.timestamp, tick_time, true);
+        }
+        else if (event.key == KEY_E)
+        {
+            *(explode) = true;
+            latency_tracker->begin(event.timestamp, tick_time, true);
         }
     }
 }
 
-void Game_DrawDebug(int &selected_sphere_colour)
+void Game_DrawDebug(int &selected_sphere_colour,
+                    const FrameStats &frame_stats,
+                    PhysicsEngine &physics_engine)
 {
     ImGui::Begin("Dev Panel");
 
-    ImGui::Text("%s", // NOLINT [cppcoreguidelines-pro-type-vararg]
-                fmt::format("FPS: {}", GetFPS()).c_str());
+    // ImGui formats into its own buffers, which keeps the panel free of heap
+    // allocations once it has been drawn a few times
+    ImGui::Text("FPS: %d", // NOLINT [cppcoreguidelines-pro-type-vararg]
+                GetFPS());
+    constexpr double kPercent{100.0};
+    constexpr double kMillisecondsPerSecond{1000.0};
+    ImGui::Text( // NOLINT [cppcoreguidelines-pro-type-vararg]
+        "Resolution scale: %.1f%% (p90 frame time %.2f ms)",
+        static_cast<double>(frame_stats.resolution_scale) * kPercent,
+        static_cast<double>(frame_stats.percentile_frame_time) *
+            kMillisecondsPerSecond);
+    ImGui::Text( // NOLINT [cppcoreguidelines-pro-type-vararg]
+        "Frame capture (F10): %s, %llu written, %llu dropped",
+        frame_stats.capturing ? "on" : "off",
+        static_cast<unsigned long long>(frame_stats.frames_captured),
+        static_cast<unsigned long long>(frame_stats.frames_dropped));
+    ImGui::Text( // NOLINT [cppcoreguidelines-pro-type-vararg]
+        "Counted allocations last frame (new, Jolt, ImGui): %llu",
+        static_cast<unsigned long long>(frame_stats.heap_allocations));
+    ImGui::Text( // NOLINT [cppcoreguidelines-pro-type-vararg]
+        "Input events dropped: %llu",
+        static_cast<unsigned long long>(frame_stats.input_overflows));
+    const LatencySummary &latency{frame_stats.input_latency};
+    ImGui::Text( // NOLINT [cppcoreguidelines-pro-type-vararg]
+        "Input to photon (F9, Space, E): p50 %.1f ms, p95 %.1f ms, "
+        "p99 %.1f ms, max %.1f ms",
+        static_cast<double>(latency.p50_milliseconds),
+        static_cast<double>(latency.p95_milliseconds),
+        static_cast<double>(latency.p99_milliseconds),
+        static_cast<double>(latency.max_milliseconds));
+    ImGui::Text( // NOLINT [cppcoreguidelines-pro-type-vararg]
+        "%llu samples, mean wait for game tick %.1f ms",
+        static_cast<unsigned long long>(latency.samples),
+        static_cast<double>(latency.mean_tick_wait_milliseconds));
+
+    const SpawnerStats &spawners{frame_stats.spawners};
+    ImGui::Text( // NOLINT [cppcoreguidelines-pro-type-vararg]
+        "Spawners: %zu live, %.0f/s spawned, %.0f/s despawned, churn %.3f ms",
+        spawners.live_bodies,
+        static_cast<double>(spawners.spawned_per_second),
+        static_cast<double>(spawners.despawned_per_second),
+        static_cast<double>(spawners.churn_milliseconds));
+    if (spawners.failed_total > 0)
+    {
+        ImGui::Text( // NOLINT [cppcoreguidelines-pro-type-vararg]
+            "%llu spawns skipped, the world is full",
+            static_cast<unsigned long long>(spawners.failed_total));
+    }
 
     if (ImGui::TreeNode("Sphere colour"))
     {
@@ -59,6 +199,12 @@ void Game_DrawDebug(int &selected_sphere_colour)
             ImGui::RadioButton(colour.c_str(), &selected_sphere_colour, index);
             ++index;
         }
+        ImGui::TreePop();
+    }
+
+    if (ImGui::CollapsingHeader("Physics settings"))
+    {
+        draw_physics_settings(physics_engine);
     }
     ImGui::End();
 }
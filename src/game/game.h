@@ -1,15 +1,39 @@
 #ifndef SRC_GAME_GAME_H
 #define SRC_GAME_GAME_H
 
+#include "input_ring.h"
+#include "latency_tracker.h"
+#include "physics/physics.h"
+#include "scene/spawner_system.h"
+
 #include <raylib.h>
 
-#include <queue>
+#include <cstdint>
+
+// Per-frame engine numbers shown in the dev panel
+struct FrameStats
+{
+    float resolution_scale;
+    float percentile_frame_time;
+    bool capturing;
+    uint64_t frames_captured;
+    uint64_t frames_dropped;
+    uint64_t heap_allocations;
+    uint64_t input_overflows;
+    LatencySummary input_latency;
+    SpawnerStats spawners;
+};
 
-void draw_scene(const Camera &camera,
-                const Vector3 &ball_position,
-                const Color &ball_colour,
-                const Font &font);
-void Game_Update(std::queue<int> *key_queue, bool *debug_menu);
-void Game_DrawDebug(int &selected_sphere_colour);
+// Consumes every input event queued since the last tick, starting a latency
+// sample for each one that changes what is on screen
+void Game_Update(InputRing *input_ring,
+                 LatencyTracker *latency_tracker,
+                 bool *debug_menu,
+                 bool *capture_frames,
+                 bool *kick_ball,
+                 bool *explode);
+void Game_DrawDebug(int &selected_sphere_colour,
+                    const FrameStats &frame_stats,
+                    PhysicsEngine &physics_engine);
 
 #endif
@@ -0,0 +1,81 @@
+#ifndef SRC_GAME_INPUT_RING_H
+#define SRC_GAME_INPUT_RING_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// A key press, stamped with the steady clock time it was polled from raylib
+struct InputEvent
+{
+    int key;
+    std::chrono::steady_clock::time_point timestamp;
+};
+
+// Fixed capacity, lock free, single producer single consumer ring buffer.
+// Storage is inline, so it never allocates. A push onto a full ring is
+// rejected and counted in overflow_count() instead of overwriting unread
+// events.
+template <typename T, std::size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+
+public:
+    // Producer side
+    bool push(const T &item)
+    {
+        const std::size_t head{_head.load(std::memory_order_relaxed)};
+        if (head - _tail.load(std::memory_order_acquire) == Capacity)
+        {
+            _overflow_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        _items[head & kMask] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T &item)
+    {
+        const std::size_t tail{_tail.load(std::memory_order_relaxed)};
+        if (tail == _head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        item = _items[tail & kMask];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return _head.load(std::memory_order_acquire) -
+               _tail.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t overflow_count() const
+    {
+        return _overflow_count.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::size_t kMask{Capacity - 1};
+    // Keep producer and consumer indices on separate cache lines
+    static constexpr std::size_t kCacheLineSize{64};
+
+    std::array<T, Capacity> _items{};
+    alignas(kCacheLineSize) std::atomic<std::size_t> _head{0};
+    alignas(kCacheLineSize) std::atomic<std::size_t> _tail{0};
+    std::atomic<uint64_t> _overflow_count{0};
+};
+
+// A frame rarely sees more than a handful of key presses, 64 leaves room for
+// a stalled consumer
+using InputRing = SpscRing<InputEvent, 64>;
+
+#endif
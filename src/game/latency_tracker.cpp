@@ -0,0 +1,120 @@
+#include "latency_tracker.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+float milliseconds_between(const LatencyTracker::Clock::time_point &start,
+                           const LatencyTracker::Clock::time_point &end)
+{
+    return std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+float percentile(std::array<float, LatencyTracker::kHistoryLength> &values,
+                 const std::size_t count,
+                 const std::size_t percent)
+{
+    constexpr std::size_t kHundred{100};
+    const std::size_t index{std::min(count - 1, count * percent / kHundred)};
+    const auto nth{values.begin() + static_cast<std::ptrdiff_t>(index)};
+    std::nth_element(values.begin(),
+                     nth,
+                     values.begin() + static_cast<std::ptrdiff_t>(count));
+    return *nth;
+}
+} // namespace
+
+void LatencyTracker::begin(const Clock::time_point input_time,
+                           const Clock::time_point tick_time,
+                           const bool needs_physics_step)
+{
+    // If every slot is busy, something is stalling presents. Replace the oldest
+    // sample rather than dropping the new one.
+    Pending *slot{&_pending.front()};
+    for (Pending &pending : _pending)
+    {
+        if (!pending.in_use)
+        {
+            slot = &pending;
+            break;
+        }
+        if (pending.input_time < slot->input_time)
+        {
+            slot = &pending;
+        }
+    }
+    *slot = Pending{input_time, tick_time, needs_physics_step, false, true};
+}
+
+void LatencyTracker::mark_physics_step()
+{
+    for (Pending &pending : _pending)
+    {
+        if (pending.in_use && pending.needs_physics_step)
+        {
+            pending.physics_stepped = true;
+        }
+    }
+}
+
+void LatencyTracker::mark_present(const Clock::time_point time)
+{
+    for (Pending &pending : _pending)
+    {
+        if (!pending.in_use ||
+            (pending.needs_physics_step && !pending.physics_stepped))
+        {
+            continue;
+        }
+        _latencies.at(_next_latency) =
+            milliseconds_between(pending.input_time, time);
+        _next_latency = (_next_latency + 1) % kHistoryLength;
+        ++_samples;
+        _total_tick_wait_milliseconds += static_cast<double>(
+            milliseconds_between(pending.input_time, pending.tick_time));
+        pending.in_use = false;
+    }
+}
+
+LatencySummary LatencyTracker::summary()
+{
+    if (_samples == 0)
+    {
+        return LatencySummary{0, 0.F, 0.F, 0.F, 0.F, 0.F};
+    }
+
+    const std::size_t count{static_cast<std::size_t>(
+        std::min<uint64_t>(_samples, kHistoryLength))};
+    _scratch = _latencies;
+    constexpr std::size_t kMedian{50};
+    constexpr std::size_t kP95{95};
+    constexpr std::size_t kP99{99};
+    const float p50{percentile(_scratch, count, kMedian)};
+    const float p95{percentile(_scratch, count, kP95)};
+    const float p99{percentile(_scratch, count, kP99)};
+    const float max{*std::max_element(
+        _scratch.begin(), _scratch.begin() + static_cast<std::ptrdiff_t>(count))};
+    return LatencySummary{
+        _samples,
+        p50,
+        p95,
+        p99,
+        max,
+        static_cast<float>(_total_tick_wait_milliseconds /
+                           static_cast<double>(_samples))};
+}
+
+const std::array<float, LatencyTracker::kHistoryLength> &
+LatencyTracker::history() const
+{
+    return _latencies;
+}
+
+std::size_t LatencyTracker::history_offset() const
+{
+    return _samples < kHistoryLength ? 0 : _next_latency;
+}
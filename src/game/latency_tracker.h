@@ -0,0 +1,65 @@
+#ifndef SRC_GAME_LATENCY_TRACKER_H
+#define SRC_GAME_LATENCY_TRACKER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+struct LatencySummary
+{
+    uint64_t samples;
+    float p50_milliseconds;
+    float p95_milliseconds;
+    float p99_milliseconds;
+    float max_milliseconds;
+    // Mean time an event waited in the input ring for the next game tick
+    float mean_tick_wait_milliseconds;
+};
+
+// Measures input to photon latency. Each input event that changes something
+// visible is followed from its poll timestamp through the game tick that
+// handles it and, if its effect goes through physics, the next physics step,
+// to the first EndDrawing that can show the result. Everything is fixed size
+// so tracking does not allocate.
+class LatencyTracker
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t kHistoryLength{256};
+
+    // Called by the game tick for an event it acted on
+    void begin(Clock::time_point input_time,
+               Clock::time_point tick_time,
+               bool needs_physics_step);
+    void mark_physics_step();
+    // Called right after EndDrawing, completes every sample that is now visible
+    void mark_present(Clock::time_point time);
+
+    [[nodiscard]] LatencySummary summary();
+    // Most recent latencies in milliseconds, oldest first from history_offset
+    [[nodiscard]] const std::array<float, kHistoryLength> &history() const;
+    [[nodiscard]] std::size_t history_offset() const;
+
+private:
+    struct Pending
+    {
+        Clock::time_point input_time;
+        Clock::time_point tick_time;
+        bool needs_physics_step;
+        bool physics_stepped;
+        bool in_use;
+    };
+
+    static constexpr std::size_t kMaxPending{8};
+
+    std::array<Pending, kMaxPending> _pending{};
+    std::array<float, kHistoryLength> _latencies{};
+    std::array<float, kHistoryLength> _scratch{};
+    std::size_t _next_latency{0};
+    uint64_t _samples{0};
+    double _total_tick_wait_milliseconds{0.0};
+};
+
+#endif
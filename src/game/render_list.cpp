@@ -0,0 +1,286 @@
+#include "render_list.h"
+
+#include "constants.h"
+
+#include <raylib.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+struct SphereDetail
+{
+    int rings;
+    int slices;
+};
+
+// Level 0 matches raylib's DrawSphere, coarser levels kick in as the projected
+// size of the sphere drops
+constexpr std::array<SphereDetail, 4> kSphereDetail{SphereDetail{16, 16},
+                                                   SphereDetail{12, 12},
+                                                   SphereDetail{8, 8},
+                                                   SphereDetail{5, 6}};
+constexpr std::array<float, 3> kLodProjectedSize{0.25F, 0.08F, 0.02F};
+constexpr float kNearPlane{0.01F};
+
+Vector3 subtract(const Vector3 &a, const Vector3 &b)
+{
+    return Vector3{a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+float dot(const Vector3 &a, const Vector3 &b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+Vector3 cross(const Vector3 &a, const Vector3 &b)
+{
+    return Vector3{a.y * b.z - a.z * b.y,
+                   a.z * b.x - a.x * b.z,
+                   a.x * b.y - a.y * b.x};
+}
+
+Vector3 normalise(const Vector3 &vector)
+{
+    const float length{std::sqrt(dot(vector, vector))};
+    if (length <= 0.F)
+    {
+        return vector;
+    }
+    return Vector3{vector.x / length, vector.y / length, vector.z / length};
+}
+
+uint64_t make_sort_key(RenderPass pass,
+                       RenderMesh mesh,
+                       uint8_t lod,
+                       const Color &colour)
+{
+    constexpr int kPassShift{56};
+    constexpr int kMeshShift{48};
+    constexpr int kLodShift{40};
+    constexpr int kRedShift{24};
+    constexpr int kGreenShift{16};
+    constexpr int kBlueShift{8};
+    return (static_cast<uint64_t>(pass) << kPassShift) |
+           (static_cast<uint64_t>(mesh) << kMeshShift) |
+           (static_cast<uint64_t>(lod) << kLodShift) |
+           (static_cast<uint64_t>(colour.r) << kRedShift) |
+           (static_cast<uint64_t>(colour.g) << kGreenShift) |
+           (static_cast<uint64_t>(colour.b) << kBlueShift) |
+           static_cast<uint64_t>(colour.a);
+}
+
+RenderCommand make_command(RenderPass pass,
+                           RenderMesh mesh,
+                           uint8_t lod,
+                           const Color &colour,
+                           const Vector3 &position,
+                           float radius,
+                           const char *text)
+{
+    return RenderCommand{make_sort_key(pass, mesh, lod, colour),
+                         pass,
+                         mesh,
+                         lod,
+                         colour,
+                         position,
+                         radius,
+                         text};
+}
+
+// View space basis and frustum half angles, computed once per list
+struct Frustum
+{
+    Vector3 eye;
+    Vector3 forward;
+    Vector3 right;
+    Vector3 up;
+    float tan_half_fov_y;
+    float sin_half_fov_x;
+    float cos_half_fov_x;
+    float sin_half_fov_y;
+    float cos_half_fov_y;
+};
+
+Frustum make_frustum(const Camera &camera, float aspect_ratio)
+{
+    const Vector3 forward{normalise(subtract(camera.target, camera.position))};
+    const Vector3 right{normalise(cross(forward, camera.up))};
+    const Vector3 up{cross(right, forward)};
+    const float half_fov_y{camera.fovy * DEG2RAD * 0.5F};
+    const float tan_half_fov_y{std::tan(half_fov_y)};
+    const float half_fov_x{std::atan(tan_half_fov_y * aspect_ratio)};
+    return Frustum{camera.position,
+                   forward,
+                   right,
+                   up,
+                   tan_half_fov_y,
+                   std::sin(half_fov_x),
+                   std::cos(half_fov_x),
+                   std::sin(half_fov_y),
+                   std::cos(half_fov_y)};
+}
+
+// Returns the view space depth of the sphere centre, or a negative value if the
+// sphere is entirely outside the frustum
+float cull_sphere(const Frustum &frustum,
+                  const Vector3 &centre,
+                  float radius)
+{
+    const Vector3 relative{subtract(centre, frustum.eye)};
+    const float depth{dot(relative, frustum.forward)};
+    if (depth + radius < kNearPlane)
+    {
+        return -1.F;
+    }
+    const float horizontal{std::fabs(dot(relative, frustum.right))};
+    const float vertical{std::fabs(dot(relative, frustum.up))};
+    if (horizontal * frustum.cos_half_fov_x - depth * frustum.sin_half_fov_x >
+            radius ||
+        vertical * frustum.cos_half_fov_y - depth * frustum.sin_half_fov_y >
+            radius)
+    {
+        return -1.F;
+    }
+    return std::max(depth, kNearPlane);
+}
+
+uint8_t select_lod(const Frustum &frustum, float depth, float radius)
+{
+    const float projected_size{radius / (depth * frustum.tan_half_fov_y)};
+    uint8_t lod{0};
+    for (const float threshold : kLodProjectedSize)
+    {
+        if (projected_size > threshold)
+        {
+            break;
+        }
+        ++lod;
+    }
+    return lod;
+}
+} // namespace
+
+void build_render_list(const Camera &camera,
+                       const float aspect_ratio,
+                       const std::vector<SphereInstance> &spheres,
+                       RenderList &render_list)
+{
+    // Clearing keeps the capacity, so after the first few frames building the
+    // list does not allocate
+    render_list.commands.clear();
+    render_list.culled = 0;
+
+    const Frustum frustum{make_frustum(camera, aspect_ratio)};
+    for (const SphereInstance &sphere : spheres)
+    {
+        const float depth{cull_sphere(frustum, sphere.position, sphere.radius)};
+        if (depth < 0.F)
+        {
+            ++render_list.culled;
+            continue;
+        }
+        render_list.commands.push_back(
+            make_command(RenderPass::World,
+                         RenderMesh::Sphere,
+                         select_lod(frustum, depth, sphere.radius),
+                         sphere.colour,
+                         sphere.position,
+                         sphere.radius,
+                         nullptr));
+    }
+
+    render_list.commands.push_back(make_command(RenderPass::World,
+                                                RenderMesh::Grid,
+                                                0,
+                                                Color{},
+                                                Vector3{},
+                                                0.F,
+                                                nullptr));
+    render_list.commands.push_back(
+        make_command(RenderPass::Overlay,
+                     RenderMesh::Text,
+                     0,
+                     DARKGRAY,
+                     Vector3{constants::kTextPositionX,
+                             constants::kTextPositionY,
+                             0.F},
+                     0.F,
+                     "Press F9 for ImGui debug mode"));
+    render_list.commands.push_back(
+        make_command(RenderPass::Overlay,
+                     RenderMesh::FPS,
+                     0,
+                     Color{},
+                     Vector3{constants::kFPSPositionX,
+                             constants::kFPSPositionY,
+                             0.F},
+                     0.F,
+                     nullptr));
+
+    std::sort(render_list.commands.begin(),
+              render_list.commands.end(),
+              [](const RenderCommand &lhs, const RenderCommand &rhs)
+              { return lhs.sort_key < rhs.sort_key; });
+}
+
+void submit_render_list(const Camera &camera,
+                        const RenderList &render_list,
+                        const Font &font,
+                        const RenderPass pass)
+{
+    const bool world_pass{pass == RenderPass::World};
+    if (world_pass)
+    {
+        BeginMode3D(camera);
+    }
+    for (const RenderCommand &command : render_list.commands)
+    {
+        if (command.pass != pass)
+        {
+            continue;
+        }
+
+        switch (command.mesh)
+        {
+        case RenderMesh::Grid:
+            DrawGrid(constants::kGridSlices, constants::kGridSpacing);
+            break;
+        case RenderMesh::Sphere:
+        {
+            const SphereDetail &detail{kSphereDetail.at(command.lod)};
+            DrawSphereEx(command.position,
+                         command.radius,
+                         detail.rings,
+                         detail.slices,
+                         command.colour);
+            break;
+        }
+        case RenderMesh::Text:
+        {
+            const float kDefaultFontSize{10.F};
+            DrawTextEx(font,
+                       command.text,
+                       Vector2{command.position.x, command.position.y},
+                       static_cast<float>(constants::kTextFontSize),
+                       static_cast<float>(constants::kTextFontSize) /
+                           kDefaultFontSize,
+                       command.colour);
+            break;
+        }
+        case RenderMesh::FPS:
+            DrawFPS(static_cast<int>(command.position.x),
+                    static_cast<int>(command.position.y));
+            break;
+        }
+    }
+    if (world_pass)
+    {
+        EndMode3D();
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef SRC_GAME_RENDER_LIST_H
+#define SRC_GAME_RENDER_LIST_H
+
+#include <raylib.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Snapshot of a ball taken on the main thread, after the physics step. The
+// render list job only ever reads these copies, so it never touches the physics
+// world or raylib state.
+struct SphereInstance
+{
+    Vector3 position;
+    float radius;
+    Color colour;
+};
+
+enum class RenderPass : uint8_t
+{
+    World,
+    Overlay
+};
+
+enum class RenderMesh : uint8_t
+{
+    Grid,
+    Sphere,
+    Text,
+    FPS
+};
+
+// One entry in the flat command buffer. Commands are sorted on sort_key, which
+// packs pass, mesh, level of detail and colour (the only material state we
+// have), so replaying the buffer in order keeps rlgl batches coherent.
+struct RenderCommand
+{
+    uint64_t sort_key;
+    RenderPass pass;
+    RenderMesh mesh;
+    uint8_t lod;
+    Color colour;
+    Vector3 position;
+    float radius;
+    const char *text;
+};
+
+struct RenderList
+{
+    std::vector<RenderCommand> commands;
+    std::size_t culled{0};
+};
+
+// Builds the command buffer for a frame: frustum culls the spheres, picks a
+// level of detail from projected size and sorts by mesh and material. Safe to
+// run on a worker thread.
+void build_render_list(const Camera &camera,
+                       float aspect_ratio,
+                       const std::vector<SphereInstance> &spheres,
+                       RenderList &render_list);
+
+// Replays the commands for one pass of a render list built by
+// build_render_list. Must be called on the main thread, between
+// BeginDrawing/EndDrawing (or BeginTextureMode/EndTextureMode). The world pass
+// can go to a lower resolution target than the overlay pass.
+void submit_render_list(const Camera &camera,
+                        const RenderList &render_list,
+                        const Font &font,
+                        RenderPass pass);
+
+#endif
@@ -0,0 +1,36 @@
+#include "render_texture_pool.h"
+
+#include "dynamic_resolution.h"
+
+#include <raylib.h>
+
+#include <cstddef>
+
+void RenderTexturePool::load(const int width, const int height)
+{
+    for (std::size_t level{1}; level < kResolutionScales.size(); ++level)
+    {
+        const float scale{kResolutionScales.at(level)};
+        RenderTexture &texture{_textures.at(level)};
+        texture = LoadRenderTexture(
+            static_cast<int>(static_cast<float>(width) * scale),
+            static_cast<int>(static_cast<float>(height) * scale));
+
+        // Bilinear filtering smooths the upscale when presenting
+        SetTextureFilter(texture.texture, TEXTURE_FILTER_BILINEAR);
+    }
+}
+
+void RenderTexturePool::unload()
+{
+    for (const RenderTexture &texture : _textures)
+    {
+        UnloadRenderTexture(texture);
+    }
+    _textures = {};
+}
+
+const RenderTexture &RenderTexturePool::get(const std::size_t level) const
+{
+    return _textures.at(level);
+}
@@ -0,0 +1,28 @@
+#ifndef SRC_GAME_RENDER_TEXTURE_POOL_H
+#define SRC_GAME_RENDER_TEXTURE_POOL_H
+
+#include "dynamic_resolution.h"
+
+#include <raylib.h>
+
+#include <array>
+#include <cstddef>
+
+// One render texture per reduced dynamic resolution level, all loaded up front.
+// Picking a new level is then just an index change, with no GPU allocation
+// mid-frame. Full resolution has no texture: the world is drawn straight to its
+// target there, keeping the window's multisampling.
+class RenderTexturePool
+{
+public:
+    void load(int width, int height);
+    void unload();
+
+    // level must be above 0
+    [[nodiscard]] const RenderTexture &get(std::size_t level) const;
+
+private:
+    std::array<RenderTexture, kResolutionScales.size()> _textures{};
+};
+
+#endif
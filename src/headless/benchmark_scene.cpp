@@ -0,0 +1,88 @@
+#include "benchmark_scene.h"
+
+#include "physics/physics.h"
+#include "physics/vec3.h"
+#include "random.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Physics/Body/BodyID.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr float kStep{1.F / 60.F};
+constexpr float kBallRadius{0.5F};
+constexpr float kSpacing{1.5F};
+constexpr float kJitter{0.2F};
+constexpr float kMaxSpeed{1.F};
+constexpr float kDropHeight{2.F};
+constexpr float kFloorMargin{5.F};
+} // namespace
+
+namespace benchmark_scene
+{
+PhysicsConfig physics_config(const std::size_t body_count)
+{
+    // One extra body for the floor
+    return physics_config_for(body_count + 1);
+}
+
+void build(PhysicsEngine &physics_engine,
+           const std::size_t body_count,
+           const uint32_t seed,
+           std::vector<JPH::BodyID> &body_ids)
+{
+    // Balls start on a square grid, stacked in layers of side * side
+    const auto side{static_cast<std::size_t>(
+        std::ceil(std::cbrt(static_cast<double>(body_count))))};
+    const float half_width{static_cast<float>(side) * kSpacing * 0.5F};
+    physics_engine.create_floor(
+        Vec3{half_width + kFloorMargin, 1.F, half_width + kFloorMargin},
+        Vec3{0.F, -1.F, 0.F});
+
+    std::mt19937 generator{seed};
+    body_ids.reserve(body_ids.size() + body_count);
+    for (std::size_t index{0}; index < body_count; ++index)
+    {
+        const std::size_t column{index % side};
+        const std::size_t row{(index / side) % side};
+        const std::size_t layer{index / (side * side)};
+        const Vec3 position{
+            static_cast<float>(column) * kSpacing - half_width +
+                next_signed_unit(generator) * kJitter,
+            kDropHeight + static_cast<float>(layer) * kSpacing,
+            static_cast<float>(row) * kSpacing - half_width +
+                next_signed_unit(generator) * kJitter};
+        const Vec3 velocity{next_signed_unit(generator) * kMaxSpeed,
+                            0.F,
+                            next_signed_unit(generator) * kMaxSpeed};
+        body_ids.push_back(
+            physics_engine.add_ball(kBallRadius, position, velocity));
+    }
+}
+
+void time_steps(PhysicsEngine &physics_engine,
+                const int warm_up_steps,
+                std::vector<float> &step_milliseconds)
+{
+    for (int step{0}; step < warm_up_steps; ++step)
+    {
+        physics_engine.step(kStep);
+    }
+    for (float &milliseconds : step_milliseconds)
+    {
+        const auto start{std::chrono::steady_clock::now()};
+        physics_engine.step(kStep);
+        milliseconds = std::chrono::duration<float, std::milli>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+    }
+}
+} // namespace benchmark_scene
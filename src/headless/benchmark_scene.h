@@ -0,0 +1,38 @@
+#ifndef SRC_HEADLESS_BENCHMARK_SCENE_H
+#define SRC_HEADLESS_BENCHMARK_SCENE_H
+
+#include "physics/physics.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Physics/Body/BodyID.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A reproducible scene for benchmarks: a floor with body_count balls dropped
+// onto it from a jittered grid. The same seed and body count always give the
+// same starting positions and velocities, on every platform.
+namespace benchmark_scene
+{
+constexpr uint32_t kDefaultSeed{20'240'501};
+
+// Room for the scene's bodies plus the pairs and contacts they generate
+[[nodiscard]] PhysicsConfig physics_config(std::size_t body_count);
+
+// Adds the floor and balls to an initialised engine, appending the ball IDs to
+// body_ids. Does not optimise the broad phase.
+void build(PhysicsEngine &physics_engine,
+           std::size_t body_count,
+           uint32_t seed,
+           std::vector<JPH::BodyID> &body_ids);
+
+// Steps the world warm_up_steps times, then times one step per element of
+// step_milliseconds
+void time_steps(PhysicsEngine &physics_engine,
+                int warm_up_steps,
+                std::vector<float> &step_milliseconds);
+} // namespace benchmark_scene
+
+#endif
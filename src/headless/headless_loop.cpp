@@ -0,0 +1,41 @@
+#include "headless_loop.h"
+
+#include "constants.h"
+#include "physics/physics.h"
+#include "physics/vec3.h"
+
+HeadlessLoop::HeadlessLoop()
+    : _sphere_position{0.F, constants::kBallInitialPositionY, 0.F}
+{
+    _physics_engine.initialise();
+    _physics_engine.create_floor(Vec3{constants::kFloorHalfExtentX,
+                                      constants::kFloorHalfExtentY,
+                                      constants::kFloorHalfExtentZ},
+                                 Vec3{0.F, constants::kFloorPositionY, 0.F});
+    _physics_engine.create_ball(
+        constants::kBallRadius,
+        _sphere_position,
+        Vec3{constants::kBallInitialVelocityX, 0.F, 0.F});
+    _physics_engine.start_simulation();
+}
+
+HeadlessLoop::~HeadlessLoop()
+{
+    _physics_engine.cleanup();
+}
+
+bool HeadlessLoop::step()
+{
+    return _physics_engine.update(1.F / static_cast<float>(constants::kTickrate),
+                           _sphere_position);
+}
+
+PhysicsEngine &HeadlessLoop::physics_engine()
+{
+    return _physics_engine;
+}
+
+const Vec3 &HeadlessLoop::sphere_position() const
+{
+    return _sphere_position;
+}
@@ -0,0 +1,31 @@
+#ifndef SRC_HEADLESS_HEADLESS_LOOP_H
+#define SRC_HEADLESS_HEADLESS_LOOP_H
+
+#include "physics/physics.h"
+#include "physics/vec3.h"
+
+// The simulation part of the app's main loop without a window: builds the same
+// floor and ball scene and steps physics at the fixed tick rate. Used by the
+// headless runner and by tests that need a realistic frame without rendering.
+class HeadlessLoop
+{
+public:
+    HeadlessLoop();
+    HeadlessLoop(const HeadlessLoop &) = delete;
+    HeadlessLoop &operator=(const HeadlessLoop &) = delete;
+    HeadlessLoop(HeadlessLoop &&) = delete;
+    HeadlessLoop &operator=(HeadlessLoop &&) = delete;
+    ~HeadlessLoop();
+
+    // Returns false when every body was asleep, so nothing was stepped
+    bool step();
+
+    [[nodiscard]] PhysicsEngine &physics_engine();
+    [[nodiscard]] const Vec3 &sphere_position() const;
+
+private:
+    PhysicsEngine _physics_engine{};
+    Vec3 _sphere_position{};
+};
+
+#endif
@@ -0,0 +1,191 @@
+#include "allocation_counter.h"
+#include "headless/headless_loop.h"
+#include "headless/perf_regression.h"
+#include "headless/spawn_stress.h"
+#include "headless/thread_scaling.h"
+#include "logging.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+namespace
+{
+constexpr int kDefaultSteps{600};
+constexpr int kWarmUpSteps{240};
+
+void print_usage()
+{
+    spdlog::info("Usage: JoltRaylibHelloWorldHeadless [--steps <count>] "
+                 "[--check-allocations]");
+    spdlog::info("       JoltRaylibHelloWorldHeadless --thread-scaling "
+                 "[--bodies <count>] [--steps <count>] "
+                 "[--max-worker-threads <count>]");
+    spdlog::info("       JoltRaylibHelloWorldHeadless --perf-check <baseline> "
+                 "[--perf-results <json>] [--repeats <count>] "
+                 "[--update-baseline]");
+    spdlog::info("       JoltRaylibHelloWorldHeadless --spawn-stress <scene> "
+                 "[--steps <count>]");
+}
+} // namespace
+
+// Steps the hello world scene without opening a window. With
+// --check-allocations, exits with a failure code if any step after warm-up
+// makes a heap allocation. With --thread-scaling, steps a larger seeded scene
+// once per job system size instead and reports how step time scales. With
+// --perf-check, measures the scenes and compares them with a baseline file.
+// With --spawn-stress, runs a scene's spawners and reports sustained churn.
+int main(int argc, char **argv)
+{
+    logging::initialise();
+    int steps{kDefaultSteps};
+    bool steps_set{false};
+    bool check_allocations{false};
+    bool thread_scaling{false};
+    ThreadScalingOptions scaling_options{};
+    PerfRegressionOptions perf_options{};
+    SpawnStressOptions spawn_options{};
+    for (int index{1}; index < argc; ++index)
+    {
+        const std::string_view argument{
+            argv[index]}; // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+        if (argument == "--steps" && index + 1 < argc)
+        {
+            steps = std::stoi(
+                argv[++index]); // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+            steps_set = true;
+        }
+        else if (argument == "--check-allocations")
+        {
+            check_allocations = true;
+        }
+        else if (argument == "--thread-scaling")
+        {
+            thread_scaling = true;
+        }
+        else if (argument == "--bodies" && index + 1 < argc)
+        {
+            scaling_options.body_count = std::stoul(
+                argv[++index]); // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+        }
+        else if (argument == "--max-worker-threads" && index + 1 < argc)
+        {
+            scaling_options.max_worker_threads = std::stoi(
+                argv[++index]); // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+        }
+        else if (argument == "--perf-check" && index + 1 < argc)
+        {
+            perf_options.baseline =
+                argv[++index]; // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+        }
+        else if (argument == "--perf-results" && index + 1 < argc)
+        {
+            perf_options.results =
+                argv[++index]; // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+        }
+        else if (argument == "--repeats" && index + 1 < argc)
+        {
+            perf_options.repeats = std::max(
+                std::stoi(
+                    argv[++index]), // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+                1);
+        }
+        else if (argument == "--spawn-stress" && index + 1 < argc)
+        {
+            spawn_options.scene =
+                argv[++index]; // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+        }
+        else if (argument == "--update-baseline")
+        {
+            perf_options.update_baseline = true;
+        }
+        else
+        {
+            print_usage();
+            logging::shutdown();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!perf_options.baseline.empty())
+    {
+        const PerfCheckResult result{run_perf_regression(perf_options)};
+        logging::shutdown();
+        switch (result)
+        {
+        case PerfCheckResult::Passed:
+            return EXIT_SUCCESS;
+        case PerfCheckResult::NoBaseline:
+            return kPerfCheckSkippedExitCode;
+        case PerfCheckResult::Regressed:
+            break;
+        }
+        return EXIT_FAILURE;
+    }
+
+    if (!spawn_options.scene.empty())
+    {
+        if (steps_set)
+        {
+            spawn_options.steps = steps;
+        }
+        SpawnStressReport report{};
+        const bool loaded{run_spawn_stress(spawn_options, report)};
+        if (loaded)
+        {
+            log_spawn_stress(report);
+        }
+        logging::shutdown();
+        return loaded ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (thread_scaling)
+    {
+        if (steps_set)
+        {
+            scaling_options.measured_steps = steps;
+        }
+        log_thread_scaling(run_thread_scaling(scaling_options));
+        logging::shutdown();
+        return EXIT_SUCCESS;
+    }
+
+    HeadlessLoop loop{};
+    uint64_t steady_state_allocations{0};
+    const auto start{std::chrono::steady_clock::now()};
+    for (int step{0}; step < steps; ++step)
+    {
+        const uint64_t allocations_before{allocation_counter::count()};
+        loop.step();
+        if (step >= kWarmUpSteps)
+        {
+            steady_state_allocations +=
+                allocation_counter::count() - allocations_before;
+        }
+    }
+
+    const std::chrono::duration<double, std::milli> elapsed{
+        std::chrono::steady_clock::now() - start};
+
+    spdlog::info("Ran {} steps, {} heap allocations after {} warm-up steps",
+                 steps,
+                 steady_state_allocations,
+                 kWarmUpSteps);
+    // The log level changes how much each step logs, so report it with the
+    // time to keep runs comparable
+    spdlog::info("Mean step time {:.4f} ms at log level {}",
+                 steps > 0 ? elapsed.count() / steps : 0.0,
+                 spdlog::level::to_string_view(spdlog::get_level()));
+    const bool allocated{check_allocations && steady_state_allocations > 0};
+    if (allocated)
+    {
+        spdlog::error("Steady state frames allocated");
+    }
+    logging::shutdown();
+    return allocated ? EXIT_FAILURE : EXIT_SUCCESS;
+}
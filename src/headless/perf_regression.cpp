@@ -0,0 +1,238 @@
+#include "perf_regression.h"
+
+#include "allocation_counter.h"
+#include "benchmark_scene.h"
+#include "headless_loop.h"
+#include "physics/physics.h"
+#include "physics/vec3.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Physics/Body/BodyID.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int kHelloWorldWarmUpSteps{240};
+constexpr float kHelloWorldKickSpeed{5.F};
+constexpr std::size_t kHelloWorldMeasuredSteps{360};
+constexpr int kSceneWarmUpSteps{60};
+constexpr std::size_t kSceneMeasuredSteps{240};
+constexpr std::size_t kSmallScene{1'000};
+constexpr std::size_t kLargeScene{10'000};
+
+// Metric name to the value from each repeat
+using Samples = std::map<std::string, std::vector<double>>;
+
+double median(std::vector<double> values)
+{
+    const auto middle{values.begin() +
+                      static_cast<std::ptrdiff_t>(values.size() / 2)};
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+double median(std::vector<float> values)
+{
+    const auto middle{values.begin() +
+                      static_cast<std::ptrdiff_t>(values.size() / 2)};
+    std::nth_element(values.begin(), middle, values.end());
+    return static_cast<double>(*middle);
+}
+
+// Steps the hello world scene, kicking the ball back up whenever it has come
+// to rest. Once every body is asleep update skips the step, so without the
+// kick the timings would only cover the sleep check. Returns false for a step
+// that was skipped.
+bool step_awake(HeadlessLoop &loop)
+{
+    if (loop.step())
+    {
+        return true;
+    }
+    loop.physics_engine().add_ball_velocity(
+        Vec3{0.F, kHelloWorldKickSpeed, 0.F});
+    return false;
+}
+
+void measure_hello_world(Samples &samples)
+{
+    HeadlessLoop loop{};
+    for (int step{0}; step < kHelloWorldWarmUpSteps; ++step)
+    {
+        step_awake(loop);
+    }
+
+    std::vector<float> step_milliseconds(kHelloWorldMeasuredSteps);
+    const uint64_t allocations_before{allocation_counter::count()};
+    for (float &milliseconds : step_milliseconds)
+    {
+        bool stepped{false};
+        while (!stepped)
+        {
+            const auto start{std::chrono::steady_clock::now()};
+            stepped = step_awake(loop);
+            milliseconds = std::chrono::duration<float, std::milli>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+        }
+    }
+    const uint64_t allocations{allocation_counter::count() -
+                               allocations_before};
+
+    samples["hello_world_step_ms"].push_back(median(step_milliseconds));
+    samples["hello_world_steady_state_allocations"].push_back(
+        static_cast<double>(allocations));
+}
+
+void measure_scene(const std::size_t body_count, Samples &samples)
+{
+    PhysicsEngine physics_engine{};
+    physics_engine.initialise(benchmark_scene::physics_config(body_count));
+    std::vector<JPH::BodyID> body_ids{};
+    benchmark_scene::build(physics_engine,
+                           body_count,
+                           benchmark_scene::kDefaultSeed,
+                           body_ids);
+
+    const auto optimise_start{std::chrono::steady_clock::now()};
+    physics_engine.start_simulation();
+    const std::chrono::duration<double, std::milli> optimise_time{
+        std::chrono::steady_clock::now() - optimise_start};
+
+    std::vector<float> step_milliseconds(kSceneMeasuredSteps);
+    benchmark_scene::time_steps(
+        physics_engine, kSceneWarmUpSteps, step_milliseconds);
+    physics_engine.cleanup();
+
+    const std::string prefix{"scene_" + std::to_string(body_count)};
+    samples[prefix + "_optimise_ms"].push_back(optimise_time.count());
+    samples[prefix + "_step_ms"].push_back(median(step_milliseconds));
+}
+
+bool read_json(const std::filesystem::path &path, nlohmann::json &json)
+{
+    std::ifstream stream{path};
+    if (!stream)
+    {
+        spdlog::error("Unable to read {}", path.string());
+        return false;
+    }
+    json = nlohmann::json::parse(stream, nullptr, false);
+    if (json.is_discarded() || !json.contains("metrics"))
+    {
+        spdlog::error("{} is not a baseline file", path.string());
+        return false;
+    }
+    return true;
+}
+
+void write_json(const std::filesystem::path &path, const nlohmann::json &json)
+{
+    std::ofstream stream{path};
+    constexpr int kIndent{2};
+    stream << json.dump(kIndent) << '\n';
+}
+} // namespace
+
+PerfCheckResult run_perf_regression(const PerfRegressionOptions &options)
+{
+    nlohmann::json baseline{};
+    if (!read_json(options.baseline, baseline))
+    {
+        return PerfCheckResult::Regressed;
+    }
+
+    // Interleave the scenes across repeats, so a slow patch on the machine is
+    // spread over every metric rather than landing on one
+    Samples samples{};
+    for (int repeat{0}; repeat < options.repeats; ++repeat)
+    {
+        spdlog::info("Run {} of {}", repeat + 1, options.repeats);
+        measure_hello_world(samples);
+        measure_scene(kSmallScene, samples);
+        measure_scene(kLargeScene, samples);
+    }
+
+    nlohmann::json results{{"repeats", options.repeats},
+                           {"metrics", nlohmann::json::object()}};
+    bool passed{true};
+    bool complete{true};
+    for (const auto &[name, values] : samples)
+    {
+        const double value{median(values)};
+        results["metrics"][name] = {{"value", value}, {"samples", values}};
+
+        nlohmann::json &expected{baseline["metrics"][name]};
+        if (!expected.is_object())
+        {
+            expected = {{"value", nullptr}, {"tolerance", 0.1}};
+        }
+        const double tolerance{expected.value("tolerance", 0.1)};
+        const double absolute_tolerance{
+            expected.value("absolute_tolerance", 0.0)};
+        if (expected["value"].is_number())
+        {
+            const double baseline_value{expected["value"].get<double>()};
+            const double limit{
+                baseline_value +
+                std::max(baseline_value * tolerance, absolute_tolerance)};
+            const bool regressed{value > limit};
+            passed = passed && !regressed;
+            const double change{baseline_value != 0.0
+                                    ? (value / baseline_value - 1.0) * 100.0
+                                    : 0.0};
+            spdlog::info("{:<40} {:>12.4f} baseline {:>12.4f} ({:+6.1f}%) "
+                         "limit {:>12.4f} {}",
+                         name,
+                         value,
+                         baseline_value,
+                         change,
+                         limit,
+                         regressed ? "REGRESSED" : "ok");
+        }
+        else
+        {
+            // Reported as skipped rather than passed, since a slowdown in
+            // this metric could not have failed the check
+            complete = false;
+            spdlog::warn("{:<40} {:>12.4f} NO BASELINE, record one with "
+                         "--update-baseline on the reference machine",
+                         name,
+                         value);
+        }
+
+        if (options.update_baseline)
+        {
+            expected["value"] = value;
+        }
+    }
+
+    if (!options.results.empty())
+    {
+        write_json(options.results, results);
+        spdlog::info("Wrote results to {}", options.results.string());
+    }
+    if (options.update_baseline)
+    {
+        write_json(options.baseline, baseline);
+        spdlog::info("Updated baseline {}", options.baseline.string());
+        return PerfCheckResult::Passed;
+    }
+    if (!passed)
+    {
+        return PerfCheckResult::Regressed;
+    }
+    return complete ? PerfCheckResult::Passed : PerfCheckResult::NoBaseline;
+}
@@ -0,0 +1,43 @@
+#ifndef SRC_HEADLESS_PERF_REGRESSION_H
+#define SRC_HEADLESS_PERF_REGRESSION_H
+
+#include <cstdint>
+#include <filesystem>
+
+struct PerfRegressionOptions
+{
+    std::filesystem::path baseline{};
+    // Current results are written here when set
+    std::filesystem::path results{};
+    // Each metric is the median of this many runs
+    int repeats{5};
+    // Replace the baseline values with this run's, keeping the tolerances
+    bool update_baseline{false};
+};
+
+enum class PerfCheckResult : uint8_t
+{
+    Passed,
+    Regressed,
+    // Nothing regressed, but some metrics have no baseline value to check
+    NoBaseline
+};
+
+// Exit code for a perf check that could not check every metric, which CTest
+// reports as skipped rather than passed or failed
+constexpr int kPerfCheckSkippedExitCode{77};
+
+// Measures the headless hello world scene and the seeded benchmark scenes,
+// then compares each metric with the baseline file. A metric regresses when it
+// is above baseline + max(baseline * tolerance, absolute_tolerance), so
+// metrics too small for a relative tolerance to rise above timer noise can
+// set an absolute allowance in their own units. A metric without a baseline
+// value cannot regress, so it makes the result NoBaseline until one is
+// recorded with update_baseline.
+//
+// The baseline is JSON of the form
+//   {"metrics": {"<name>": {"value": <number or null>, "tolerance": 0.1,
+//                           "absolute_tolerance": 0.0}}}
+[[nodiscard]] PerfCheckResult run_perf_regression(const PerfRegressionOptions &options);
+
+#endif
@@ -0,0 +1,113 @@
+#include "spawn_stress.h"
+
+#include "physics/physics.h"
+#include "scene/scene_loader.h"
+#include "scene/scene_parser.h"
+#include "scene/spawner_system.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace
+{
+constexpr int kSpawnStressStepsPerSecond{60};
+constexpr float kSpawnStressStep{
+    1.F / static_cast<float>(kSpawnStressStepsPerSecond)};
+} // namespace
+
+bool run_spawn_stress(const SpawnStressOptions &options,
+                      SpawnStressReport &report)
+{
+    PhysicsEngine physics_engine{};
+    SceneLoader scene_loader{physics_engine};
+    if (!scene_parser::parse_file(options.scene, scene_loader))
+    {
+        return false;
+    }
+    if (scene_loader.spawners().empty())
+    {
+        spdlog::warn("{} has no spawners", options.scene.string());
+    }
+    physics_engine.start_simulation();
+
+    SpawnerSystem spawner_system{physics_engine};
+    spawner_system.set_spawners(scene_loader.spawners());
+
+    float step_total{0.F};
+    float churn_total{0.F};
+    for (int step{1}; step <= options.steps; ++step)
+    {
+        spawner_system.update(kSpawnStressStep);
+        const auto start{std::chrono::steady_clock::now()};
+        physics_engine.step(kSpawnStressStep);
+        step_total += std::chrono::duration<float, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+        const SpawnerStats &stats{spawner_system.stats()};
+        churn_total += stats.churn_milliseconds;
+        report.peak_live_bodies =
+            std::max(report.peak_live_bodies, stats.live_bodies);
+
+        if (step % kSpawnStressStepsPerSecond == 0)
+        {
+            const SpawnStressSecond second{
+                stats.live_bodies,
+                stats.spawned_per_second,
+                stats.despawned_per_second,
+                step_total / static_cast<float>(kSpawnStressStepsPerSecond),
+                churn_total / static_cast<float>(kSpawnStressStepsPerSecond)};
+            report.seconds.push_back(second);
+            if (report.over_budget_live_bodies == 0 &&
+                second.mean_step_milliseconds +
+                        second.mean_churn_milliseconds >
+                    options.budget_milliseconds)
+            {
+                report.over_budget_live_bodies = second.live_bodies;
+            }
+            step_total = 0.F;
+            churn_total = 0.F;
+        }
+    }
+
+    const SpawnerStats &stats{spawner_system.stats()};
+    report.spawned_total = stats.spawned_total;
+    report.despawned_total = stats.despawned_total;
+    report.failed_total = stats.failed_total;
+    spawner_system.clear();
+    physics_engine.cleanup();
+    return true;
+}
+
+void log_spawn_stress(const SpawnStressReport &report)
+{
+    spdlog::info("second     live  spawned/s  despawned/s  step ms  churn ms");
+    std::size_t second_index{1};
+    for (const SpawnStressSecond &second : report.seconds)
+    {
+        spdlog::info("{:>6} {:>8} {:>10.0f} {:>12.0f} {:>8.3f} {:>9.3f}",
+                     second_index++,
+                     second.live_bodies,
+                     second.spawned_per_second,
+                     second.despawned_per_second,
+                     second.mean_step_milliseconds,
+                     second.mean_churn_milliseconds);
+    }
+    spdlog::info("{} spawned, {} despawned, {} skipped with the world full, "
+                 "peak {} live",
+                 report.spawned_total,
+                 report.despawned_total,
+                 report.failed_total,
+                 report.peak_live_bodies);
+    if (report.over_budget_live_bodies > 0)
+    {
+        spdlog::warn("Frame budget first missed with {} live bodies",
+                     report.over_budget_live_bodies);
+    }
+    else
+    {
+        spdlog::info("Every second stayed within the frame budget");
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef SRC_HEADLESS_SPAWN_STRESS_H
+#define SRC_HEADLESS_SPAWN_STRESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+struct SpawnStressOptions
+{
+    std::filesystem::path scene{};
+    int steps{3'600};
+    // Steps slower than this, churn included, miss the frame
+    float budget_milliseconds{1'000.F / 60.F};
+};
+
+// One simulated second of a stress run
+struct SpawnStressSecond
+{
+    std::size_t live_bodies;
+    float spawned_per_second;
+    float despawned_per_second;
+    float mean_step_milliseconds;
+    float mean_churn_milliseconds;
+};
+
+struct SpawnStressReport
+{
+    std::vector<SpawnStressSecond> seconds{};
+    std::size_t peak_live_bodies{0};
+    uint64_t spawned_total{0};
+    uint64_t despawned_total{0};
+    uint64_t failed_total{0};
+    // Live bodies in the first second whose mean step plus churn went over
+    // budget, or 0 if every second kept up
+    std::size_t over_budget_live_bodies{0};
+};
+
+// Loads a scene with spawners and steps it at 60 Hz, spawning and despawning
+// as the game does, to find how much churn the engine sustains
+[[nodiscard]] bool run_spawn_stress(const SpawnStressOptions &options,
+                                    SpawnStressReport &report);
+void log_spawn_stress(const SpawnStressReport &report);
+
+#endif
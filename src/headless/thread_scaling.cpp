@@ -0,0 +1,133 @@
+#include "thread_scaling.h"
+
+#include "benchmark_scene.h"
+#include "physics/physics.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Physics/Body/BodyID.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Runs within this fraction of the fastest median count as no slower
+constexpr float kKneeTolerance{1.05F};
+
+float percentile(std::vector<float> &values, const std::size_t percent)
+{
+    constexpr std::size_t kHundred{100};
+    const std::size_t index{
+        std::min(values.size() - 1, values.size() * percent / kHundred)};
+    const auto nth{values.begin() + static_cast<std::ptrdiff_t>(index)};
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+}
+
+ThreadScalingResult measure(const ThreadScalingOptions &options,
+                            const int worker_threads)
+{
+    PhysicsConfig config{benchmark_scene::physics_config(options.body_count)};
+    config.worker_threads = worker_threads;
+
+    PhysicsEngine physics_engine{};
+    physics_engine.initialise(config);
+    std::vector<JPH::BodyID> body_ids{};
+    benchmark_scene::build(
+        physics_engine, options.body_count, options.seed, body_ids);
+    physics_engine.start_simulation();
+
+    std::vector<float> step_milliseconds(
+        static_cast<std::size_t>(std::max(options.measured_steps, 1)));
+    benchmark_scene::time_steps(
+        physics_engine, options.warm_up_steps, step_milliseconds);
+    physics_engine.cleanup();
+
+    const float total{std::accumulate(
+        step_milliseconds.begin(), step_milliseconds.end(), 0.F)};
+    ThreadScalingResult result{};
+    result.threads = worker_threads + 1;
+    result.mean_milliseconds =
+        total / static_cast<float>(step_milliseconds.size());
+    result.max_milliseconds =
+        *std::max_element(step_milliseconds.begin(), step_milliseconds.end());
+    constexpr std::size_t kMedian{50};
+    constexpr std::size_t kP90{90};
+    constexpr std::size_t kP99{99};
+    result.p50_milliseconds = percentile(step_milliseconds, kMedian);
+    result.p90_milliseconds = percentile(step_milliseconds, kP90);
+    result.p99_milliseconds = percentile(step_milliseconds, kP99);
+    return result;
+}
+} // namespace
+
+ThreadScalingReport run_thread_scaling(const ThreadScalingOptions &options)
+{
+    const int max_worker_threads{
+        options.max_worker_threads >= 0
+            ? options.max_worker_threads
+            : std::max(
+                  static_cast<int>(std::thread::hardware_concurrency()) - 1,
+                  0)};
+
+    ThreadScalingReport report{};
+    for (int worker_threads{0}; worker_threads <= max_worker_threads;
+         ++worker_threads)
+    {
+        spdlog::info("Measuring {} threads", worker_threads + 1);
+        report.results.push_back(measure(options, worker_threads));
+    }
+
+    summarise_thread_scaling(report);
+    return report;
+}
+
+void summarise_thread_scaling(ThreadScalingReport &report)
+{
+    if (report.results.empty())
+    {
+        return;
+    }
+    const float single_thread{report.results.front().p50_milliseconds};
+    float fastest{single_thread};
+    for (ThreadScalingResult &result : report.results)
+    {
+        result.speedup = single_thread / result.p50_milliseconds;
+        result.efficiency = result.speedup / static_cast<float>(result.threads);
+        fastest = std::min(fastest, result.p50_milliseconds);
+    }
+    for (const ThreadScalingResult &result : report.results)
+    {
+        if (result.p50_milliseconds <= fastest * kKneeTolerance)
+        {
+            report.knee_threads = result.threads;
+            break;
+        }
+    }
+}
+
+void log_thread_scaling(const ThreadScalingReport &report)
+{
+    spdlog::info("threads  mean ms   p50 ms   p90 ms   p99 ms   max ms  "
+                 "speedup  efficiency");
+    for (const ThreadScalingResult &result : report.results)
+    {
+        spdlog::info("{:>7} {:>8.3f} {:>8.3f} {:>8.3f} {:>8.3f} {:>8.3f} "
+                     "{:>8.2f} {:>10.0f}%",
+                     result.threads,
+                     result.mean_milliseconds,
+                     result.p50_milliseconds,
+                     result.p90_milliseconds,
+                     result.p99_milliseconds,
+                     result.max_milliseconds,
+                     result.speedup,
+                     result.efficiency * 100.F);
+    }
+    spdlog::info("Adding threads stops helping after {} threads",
+                 report.knee_threads);
+}
@@ -0,0 +1,53 @@
+#ifndef SRC_HEADLESS_THREAD_SCALING_H
+#define SRC_HEADLESS_THREAD_SCALING_H
+
+#include "benchmark_scene.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct ThreadScalingOptions
+{
+    std::size_t body_count{10'000};
+    uint32_t seed{benchmark_scene::kDefaultSeed};
+    int warm_up_steps{60};
+    int measured_steps{300};
+    // Runs 0 to max_worker_threads workers. Negative means one fewer than the
+    // number of hardware threads.
+    int max_worker_threads{-1};
+};
+
+// Step time distribution for one job system size. threads counts the workers
+// plus the thread calling update, which also runs jobs while it waits.
+struct ThreadScalingResult
+{
+    int threads{0};
+    float mean_milliseconds{0.F};
+    float p50_milliseconds{0.F};
+    float p90_milliseconds{0.F};
+    float p99_milliseconds{0.F};
+    float max_milliseconds{0.F};
+    // Median single thread step time over this run's median
+    float speedup{0.F};
+    // speedup / threads
+    float efficiency{0.F};
+};
+
+struct ThreadScalingReport
+{
+    std::vector<ThreadScalingResult> results{};
+    // Fewest threads whose median step is within a few percent of the fastest
+    // run. Past this point more threads stop helping.
+    int knee_threads{0};
+};
+
+// Steps the same seeded benchmark scene with each job system size in turn
+[[nodiscard]] ThreadScalingReport run_thread_scaling(
+    const ThreadScalingOptions &options);
+// Fills in each result's speedup and efficiency, and the report's knee, from
+// the medians. The first result is taken as the single thread run.
+void summarise_thread_scaling(ThreadScalingReport &report);
+void log_thread_scaling(const ThreadScalingReport &report);
+
+#endif
@@ -0,0 +1,68 @@
+#include "logging.h"
+
+#include <spdlog/async.h>
+#include <spdlog/async_logger.h>
+#include <spdlog/cfg/env.h>
+#include <spdlog/common.h>
+#include <spdlog/logger.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace
+{
+// Messages, not bytes. Each slot holds a message of up to 250 characters
+// without touching the heap.
+constexpr std::size_t kQueueSize{8'192};
+constexpr std::size_t kWorkerThreads{1};
+
+std::shared_ptr<spdlog::logger> sJoltLogger{};
+} // namespace
+
+namespace logging
+{
+void initialise()
+{
+    spdlog::init_thread_pool(kQueueSize, kWorkerThreads);
+    const auto sink{std::make_shared<spdlog::sinks::stdout_color_sink_mt>()};
+
+    auto logger{std::make_shared<spdlog::async_logger>(
+        "app",
+        sink,
+        spdlog::thread_pool(),
+        spdlog::async_overflow_policy::overrun_oldest)};
+    sJoltLogger = std::make_shared<spdlog::async_logger>(
+        "jolt",
+        sink,
+        spdlog::thread_pool(),
+        spdlog::async_overflow_policy::overrun_oldest);
+
+    // Errors are rare and usually followed by an exit, so write them out
+    // straight away
+    logger->flush_on(spdlog::level::err);
+    sJoltLogger->flush_on(spdlog::level::err);
+    spdlog::register_logger(sJoltLogger);
+    spdlog::set_default_logger(logger);
+
+    // SPDLOG_LEVEL=trace in the environment shows the per-step messages in
+    // Debug builds
+    spdlog::cfg::load_env_levels();
+}
+
+void shutdown()
+{
+    sJoltLogger.reset();
+    spdlog::shutdown();
+}
+
+spdlog::logger &jolt()
+{
+    if (sJoltLogger != nullptr)
+    {
+        return *sJoltLogger;
+    }
+    return *spdlog::default_logger_raw();
+}
+} // namespace logging
@@ -0,0 +1,28 @@
+#ifndef SRC_LOGGING_H
+#define SRC_LOGGING_H
+
+#include <spdlog/logger.h>
+
+// Process wide logging set up. initialise() replaces spdlog's default logger
+// with an asynchronous one, so formatting happens on the calling thread but
+// console I/O moves to a background thread fed by a preallocated queue. When
+// the queue is full the oldest messages are overwritten rather than blocking
+// the main loop or physics jobs. Jolt's trace and assert output goes through
+// the same sink via jolt().
+//
+// Per-step and per-contact messages use the SPDLOG_TRACE and SPDLOG_DEBUG
+// macros. SPDLOG_ACTIVE_LEVEL is set per build type in CMakeLists.txt, so those
+// calls are compiled out entirely in Release and Distribution builds. In Debug
+// builds they are filtered at run time unless SPDLOG_LEVEL asks for them.
+namespace logging
+{
+void initialise();
+// Flushes queued messages and stops the background thread
+void shutdown();
+
+// Logger for messages from Jolt, falls back to the default logger when
+// initialise() has not been called (for example in unit tests)
+[[nodiscard]] spdlog::logger &jolt();
+} // namespace logging
+
+#endif
@@ -1,6 +1,26 @@
+#include "allocation_counter.h"
+#include "assets/asset_archive.h"
+#include "command_line.h"
 #include "constants.h"
+#include "game/body_inspector.h"
+#include "game/dynamic_resolution.h"
+#include "game/frame_capture.h"
 #include "game/game.h"
-#include "physics.h"
+#include "game/input_ring.h"
+#include "game/latency_tracker.h"
+#include "game/render_list.h"
+#include "game/render_texture_pool.h"
+#include "logging.h"
+#include "physics/flight_recorder.h"
+#include "physics/physics.h"
+#include "platform/file_watcher.h"
+#include "scene/scene.h"
+#include "scene/scene_loader.h"
+#include "scene/scene_parser.h"
+#include "scene/destructible_system.h"
+#include "scene/spawner_system.h"
+#include "startup_timer.h"
+#include "tuning.h"
 
 #include <imgui.h>
 #include <raylib.h>
@@ -10,42 +30,241 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
-#include <queue>
+#include <cstdlib>
+#include <chrono>
+#include <filesystem>
+#include <future>
 #include <string>
+#include <string_view>
+#include <vector>
 
-void setup_camera(Camera3D &camera)
+void setup_camera(Camera3D &camera, const Tuning &tuning)
 {
-    camera.position = Vector3{constants::kCameraPositionX,
-                              constants::kCameraPositionY,
-                              constants::kCameraPositionZ};
-    constexpr float kCameraTargetX{0.F};
-    camera.target = Vector3{kCameraTargetX, 0.F, 0.F};
+    camera.position = Vector3{tuning.camera_position.x,
+                              tuning.camera_position.y,
+                              tuning.camera_position.z};
+    camera.target = Vector3{tuning.camera_target.x,
+                            tuning.camera_target.y,
+                            tuning.camera_target.z};
     camera.up = Vector3{0.F, 1.F, 0.F};
-    camera.fovy = constants::kCameraFovY;
+    camera.fovy = tuning.camera_fovy;
     camera.projection = CAMERA_PERSPECTIVE;
 }
 
-int main(int /* argc */, char ** /* argv */)
+// Dear ImGui takes its memory with malloc, which the allocation counter cannot
+// see, so route it through functions that record each allocation
+void *counted_imgui_allocate(const std::size_t size, void * /* user_data */)
 {
+    allocation_counter::record();
+    return std::malloc(size); // NOLINT [cppcoreguidelines-no-malloc]
+}
+
+void counted_imgui_free(void *pointer, void * /* user_data */)
+{
+    std::free(pointer); // NOLINT [cppcoreguidelines-no-malloc]
+}
+
+// Settings the tuning does not cover, such as the sleep thresholds, keep
+// whatever value they have, including edits made in the debug menu
+void apply_physics_tuning(const PhysicsTuning &tuning,
+                          PhysicsEngine &physics_engine)
+{
+    JPH::PhysicsSettings settings{physics_engine.get_physics_settings()};
+    settings.mNumVelocitySteps = tuning.velocity_steps;
+    settings.mNumPositionSteps = tuning.position_steps;
+    settings.mBaumgarte = tuning.baumgarte;
+    settings.mSpeculativeContactDistance = tuning.speculative_contact_distance;
+    settings.mPenetrationSlop = tuning.penetration_slop;
+    settings.mAllowSleeping = tuning.allow_sleeping;
+    physics_engine.set_physics_settings(settings);
+    physics_engine.set_gravity(tuning.gravity);
+}
+
+// Loads a font straight from the mapped asset archive, matching the size and
+// filtering LoadFont uses. Falls back to raylib's default font if the asset
+// is missing.
+Font load_font(const AssetArchive &assets, const std::string_view name)
+{
+    constexpr int kFontSize{32};
+    Font font{};
+    AssetView asset{};
+    if (assets.find(name, asset))
+    {
+        font = LoadFontFromMemory(".ttf",
+                                  asset.data,
+                                  static_cast<int>(asset.size),
+                                  kFontSize,
+                                  nullptr,
+                                  0);
+    }
+    else
+    {
+        spdlog::error("Asset {} not found", name);
+    }
+    if (font.texture.id == 0)
+    {
+        return GetFontDefault();
+    }
+    SetTextureFilter(font.texture, TEXTURE_FILTER_POINT);
+    return font;
+}
+
+// The hello world scene: a ball dropped onto a floor. Used when no scene file
+// is given.
+void build_default_scene(SceneSink &sink)
+{
+    sink.begin(SceneWorld{});
+
+    SceneBody floor{};
+    floor.shape = SceneShape::Box;
+    floor.motion = SceneMotion::Static;
+    floor.position = Vec3{0.F, constants::kFloorPositionY, 0.F};
+    floor.half_extents = Vec3{constants::kFloorHalfExtentX,
+                              constants::kFloorHalfExtentY,
+                              constants::kFloorHalfExtentZ};
+
+    constexpr float kBallRestitution{0.8F};
+    SceneBody ball{};
+    ball.position = Vec3{0.F, constants::kBallInitialPositionY, 0.F};
+    ball.radius = constants::kBallRadius;
+    ball.velocity = Vec3{constants::kBallInitialVelocityX, 0.F, 0.F};
+    ball.material.restitution = kBallRestitution;
+    ball.ball = true;
+
+    sink.add_bodies(std::vector<SceneBody>{floor, ball});
+    sink.end();
+}
+
+// Gathers every sphere to draw. The ball takes the colour picked in the debug
+// menu, the other spheres cycle through the palette. Spawned spheres follow
+// the scene's own, then destructible parts and their debris. Reads body
+// positions without locking, so runs only while the world is not stepping.
+void build_sphere_instances(const PhysicsEngine &physics_engine,
+                            const SceneLoader &scene_loader,
+                            const SpawnerSystem &spawner_system,
+                            const DestructibleSystem &destructible_system,
+                            const int selected_sphere_colour,
+                            std::vector<SphereInstance> &sphere_instances)
+{
+    const std::vector<SceneSphere> &scene_spheres{scene_loader.spheres()};
+    const std::vector<SceneSphere> &spawned_spheres{spawner_system.spheres()};
+    sphere_instances.resize(scene_spheres.size() + spawned_spheres.size());
+    for (std::size_t index{0}; index < sphere_instances.size(); ++index)
+    {
+        const SceneSphere &scene_sphere{
+            index < scene_spheres.size()
+                ? scene_spheres[index]
+                : spawned_spheres[index - scene_spheres.size()]};
+        SphereInstance &instance{sphere_instances[index]};
+        Vec3 position{0.F, 0.F, 0.F};
+        if (physics_engine.get_body_position(scene_sphere.id, position))
+        {
+            instance.position = Vector3{position.x, position.y, position.z};
+        }
+        instance.radius = scene_sphere.radius;
+        instance.colour =
+            scene_sphere.id == scene_loader.ball()
+                ? constants::kSphereColours[static_cast<std::size_t>(
+                      selected_sphere_colour)]
+                : constants::kSphereColours[index %
+                                            constants::kSphereColours.size()];
+    }
+    for (const DestructibleSphere &part : destructible_system.spheres())
+    {
+        sphere_instances.push_back(SphereInstance{
+            Vector3{part.position.x, part.position.y, part.position.z},
+            part.radius,
+            constants::kSphereColours[sphere_instances.size() %
+                                      constants::kSphereColours.size()]});
+    }
+}
+
+int main(int argc, char **argv)
+{
+    StartupTimer startup_timer{};
+    logging::initialise();
+    const CommandLineOptions options{parse_command_line(argc, argv)};
+    Tuning tuning{};
+    if (!options.tuning.empty())
+    {
+        tuning_file::parse_file(options.tuning, tuning);
+    }
     double tickTimer{0.0};
-    std::queue<int> keyQueue{std::queue<int>()};
+    InputRing inputRing{};
+    LatencyTracker latencyTracker{};
+    bool kickBall = false;
+    bool explode = false;
     bool debugMenu = false;
+    bool captureFrames = false;
     const Vector2 windowSize{
         Vector2{constants::kWindowWidth, constants::kWindowHeight}};
     RenderTexture gameTexture;
-    RenderTexture debugTexture;
+    // Only needed once the debug interface is opened, so it and Dear ImGui
+    // are set up on the first F9 press rather than at startup
+    RenderTexture debugTexture{};
+    bool debug_interface_loaded{false};
+
+    // Physics setup does not need the window, so it runs on a worker thread
+    // while the window, render textures and assets are loaded. The scene
+    // loader initialises the engine, sized for the scene.
+    Vec3 sphere_position{0.F, constants::kBallInitialPositionY, 0.F};
+    PhysicsEngine physics_engine{};
+    SceneLoader scene_loader{physics_engine};
+    std::future<bool> physics_ready{std::async(
+        std::launch::async,
+        [&]()
+        {
+            const bool scene_loaded{startup_timer.time(
+                "Physics scene",
+                [&]()
+                {
+                    if (options.scene.empty())
+                    {
+                        build_default_scene(scene_loader);
+                        return true;
+                    }
+                    return scene_parser::parse_file(options.scene,
+                                                    scene_loader);
+                })};
+            if (!scene_loaded)
+            {
+                return false;
+            }
+            startup_timer.time("Physics optimise",
+                               [&]() { physics_engine.start_simulation(); });
+            spdlog::info("Scene has {} bodies, built as {} physics bodies",
+                         scene_loader.body_count(),
+                         scene_loader.world_body_count());
+            return true;
+        })};
 
-    SetWindowState(FLAG_MSAA_4X_HINT);
-    InitWindow(static_cast<int>(windowSize.x),
-               static_cast<int>(windowSize.y),
-               constants::kTitle.c_str());
-    rlImGuiSetup(true);
+    startup_timer.time("Window",
+                       [&]()
+                       {
+                           SetWindowState(FLAG_MSAA_4X_HINT);
+                           InitWindow(static_cast<int>(windowSize.x),
+                                      static_cast<int>(windowSize.y),
+                                      constants::kTitle.c_str());
+                       });
 
+    const auto render_textures_start{StartupTimer::Clock::now()};
     gameTexture = LoadRenderTexture((int)windowSize.x, (int)windowSize.y);
+
+    // The 3D world is rendered at a lower internal resolution when frames run
+    // over budget, then upscaled when presenting. The overlay text is always
+    // drawn at full resolution.
+    RenderTexturePool worldTextures{};
+    worldTextures.load(static_cast<int>(windowSize.x),
+                       static_cast<int>(windowSize.y));
+    DynamicResolution dynamic_resolution{
+        1.F / static_cast<float>(constants::kTargetFramerate)};
+    const Rectangle window_rectangle{0, 0, windowSize.x, windowSize.y};
+    const Rectangle game_source_rectangle{0, 0, windowSize.x, -windowSize.y};
+    startup_timer.record(
+        "Render textures", render_textures_start, StartupTimer::Clock::now());
+    FrameCapture frame_capture{};
+    BodyInspector body_inspector{};
     constexpr float kDebugScaleUp{1.5F};
-    debugTexture =
-        LoadRenderTexture(static_cast<int>(windowSize.x / kDebugScaleUp),
-                          static_cast<int>(windowSize.y / kDebugScaleUp));
 
     const Rectangle source_rectangle{0,
                                      -windowSize.y,
@@ -56,69 +275,243 @@ int main(int /* argc */, char ** /* argv */)
                                           windowSize.x / kDebugScaleUp,
                                           windowSize.y / kDebugScaleUp};
     Camera3D camera{};
-    setup_camera(camera);
+    setup_camera(camera, tuning);
 
     constexpr int kMillisecondsPerSecond{1000};
-    constexpr float kBallInitialPositionY{10.F};
-    Vector3 sphere_position{0.F, kBallInitialPositionY, 0.F};
-    const Vector3 sphere_velocity{0.5F, 0.F, 0.F};
-    const Font font{LoadFont(ASSETS_PATH "ibm-plex-mono-v19-latin-500.ttf")};
     int selected_sphere_colour{0};
 
-    const Vector3 floor_position{0.F, -1.F, 0.F};
-    const Vector3 floor_dimensions{5.F, 1.F, 5.F};
+    // Assets are read in place from the mapped archive, so the only copies
+    // made are the ones raylib uploads to the GPU
+    AssetArchive assets{};
+    startup_timer.time("Asset archive",
+                       [&]()
+                       {
+                           assets.open(std::filesystem::path{
+                                           GetApplicationDirectory()} /
+                                       ASSET_ARCHIVE_NAME);
+                       });
+    const Font font{startup_timer.time(
+        "Font",
+        [&]()
+        { return load_font(assets, "ibm-plex-mono-v19-latin-500.ttf"); })};
 
-    spdlog::info("Creating Physics Engine");
-    PhysicsEngine physics_engine{};
-
-    spdlog::info("Initialising Physics Engine");
-    physics_engine.initialise();
-
-    spdlog::info("Creating floor");
-    physics_engine.create_floor(floor_dimensions, floor_position);
+    FlightRecorder flight_recorder{};
+    if (!options.flight_recorder.empty())
+    {
+        startup_timer.time("Flight recorder",
+                           [&]()
+                           { flight_recorder.open(options.flight_recorder); });
+    }
 
-    spdlog::info("Creating ball");
-    physics_engine.create_ball(constants::kBallRadius,
-                               sphere_position,
-                               sphere_velocity);
+    // Nothing below may touch the physics engine until setup has finished
+    const bool physics_loaded{startup_timer.time(
+        "Wait for physics", [&]() { return physics_ready.get(); })};
+    if (!physics_loaded)
+    {
+        spdlog::error("Unable to load scene {}", options.scene.string());
+        UnloadFont(font);
+        assets.close();
+        worldTextures.unload();
+        CloseWindow();
+        logging::shutdown();
+        return 1;
+    }
+    apply_physics_tuning(tuning.physics, physics_engine);
 
-    spdlog::info("Initiating Pre-simulation Optimisation");
-    physics_engine.start_simulation();
+    // The tuning and scene files are applied again whenever they are saved
+    FileWatcher file_watcher{};
+    const bool watch_tuning{!options.tuning.empty()};
+    const bool watch_scene{!options.scene.empty()};
+    const std::size_t tuning_watch{
+        watch_tuning ? file_watcher.watch(options.tuning) : 0};
+    const std::size_t scene_watch{
+        watch_scene ? file_watcher.watch(options.scene) : 0};
 
     // We simulate the physics world in discrete time steps. 60 Hz is a good rate
     // to update the physics system.
     SetTargetFPS(constants::kTargetFramerate);
 
+    // The render list for the next frame is built on the physics job system
+    // while the main thread handles input, so drawing is reduced to replaying
+    // the command buffer
+    const float aspect_ratio{windowSize.x / windowSize.y};
+    const std::vector<SceneSphere> &scene_spheres{scene_loader.spheres()};
+    SpawnerSystem spawner_system{physics_engine};
+    spawner_system.set_spawners(scene_loader.spawners());
+    DestructibleSystem destructible_system{physics_engine};
+    destructible_system.set_destructibles(scene_loader.destructibles());
+    std::vector<SphereInstance> sphere_instances{};
+    sphere_instances.reserve(scene_spheres.size() + spawner_system.capacity() +
+                             destructible_system.capacity());
+    RenderList render_list{};
+    JPH::JobHandle render_list_job{};
+
+    // The job captures a single pointer so it fits in std::function's small
+    // buffer, and kicking it every frame does not allocate. It gathers the
+    // sphere positions itself, so the main thread does no per-sphere work;
+    // nothing touches the world or the sphere lists between kicking the job
+    // and waiting for it.
+    struct RenderListInputs
+    {
+        const Camera3D *camera;
+        float aspect_ratio;
+        const PhysicsEngine *physics_engine;
+        const SceneLoader *scene_loader;
+        const SpawnerSystem *spawner_system;
+        const DestructibleSystem *destructible_system;
+        const int *selected_sphere_colour;
+        std::vector<SphereInstance> *sphere_instances;
+        RenderList *render_list;
+    };
+    const RenderListInputs render_list_inputs{&camera,
+                                              aspect_ratio,
+                                              &physics_engine,
+                                              &scene_loader,
+                                              &spawner_system,
+                                              &destructible_system,
+                                              &selected_sphere_colour,
+                                              &sphere_instances,
+                                              &render_list};
+    const auto kick_render_list_job{
+        [&]()
+        {
+            render_list_job = physics_engine.create_job(
+                "Build render list",
+                [inputs = &render_list_inputs]()
+                {
+                    build_sphere_instances(*inputs->physics_engine,
+                                           *inputs->scene_loader,
+                                           *inputs->spawner_system,
+                                           *inputs->destructible_system,
+                                           *inputs->selected_sphere_colour,
+                                           *inputs->sphere_instances);
+                    build_render_list(*inputs->camera,
+                                      inputs->aspect_ratio,
+                                      *inputs->sphere_instances,
+                                      *inputs->render_list);
+                });
+        }};
+
+    // Frames before this are allowed to allocate while containers, caches and
+    // Jolt's pools reach their working size
+    constexpr uint64_t kSteadyStateWarmUpFrames{120};
+
     spdlog::info("Starting Simulation");
 
+    kick_render_list_job();
+    bool first_frame{true};
+    uint64_t frame_count{0};
+    uint64_t frame_allocations{0};
     while (!WindowShouldClose())
     {
+        const uint64_t allocations_at_frame_start{allocation_counter::count()};
         const float frame_time{GetFrameTime()};
+        dynamic_resolution.add_frame_time(frame_time);
         if (GetTime() - tickTimer >
             static_cast<float>(kMillisecondsPerSecond) /
-                static_cast<float>(constants::kTickrate) /
+                static_cast<float>(tuning.tickrate) /
                 static_cast<float>(kMillisecondsPerSecond))
         {
             tickTimer = GetTime();
-            Game_Update(&keyQueue, &debugMenu);
+            Game_Update(&inputRing,
+                        &latencyTracker,
+                        &debugMenu,
+                        &captureFrames,
+                        &kickBall,
+                        &explode);
+        }
+
+        if (debugMenu && !debug_interface_loaded)
+        {
+            startup_timer.time(
+                "Debug interface",
+                [&]()
+                {
+                    ImGui::SetAllocatorFunctions(counted_imgui_allocate,
+                                                 counted_imgui_free);
+                    rlImGuiSetup(true);
+                    debugTexture = LoadRenderTexture(
+                        static_cast<int>(windowSize.x / kDebugScaleUp),
+                        static_cast<int>(windowSize.y / kDebugScaleUp));
+                });
+            debug_interface_loaded = true;
+            spdlog::info("Debug interface loaded");
+        }
+
+        if (captureFrames && !frame_capture.capturing())
+        {
+            if (!frame_capture.start(options.capture_directory,
+                                     options.capture_format,
+                                     gameTexture.texture.width,
+                                     gameTexture.texture.height))
+            {
+                captureFrames = false;
+            }
+        }
+        else if (!captureFrames && frame_capture.capturing())
+        {
+            frame_capture.stop();
         }
 
-        keyQueue.push(GetKeyPressed());
+        physics_engine.wait_for_job(render_list_job);
+
+        // Render textures are not multisampled, so at full resolution the
+        // world is drawn straight to its target and keeps the window's MSAA.
+        // Only reduced levels go through a pooled texture and are upscaled.
+        const std::size_t resolution_level{dynamic_resolution.level()};
+        const auto draw_world{
+            [&]()
+            {
+                if (resolution_level == 0)
+                {
+                    ClearBackground(RAYWHITE);
+                    submit_render_list(
+                        camera, render_list, font, RenderPass::World);
+                    return;
+                }
+                const RenderTexture &worldTexture{
+                    worldTextures.get(resolution_level)};
+                DrawTexturePro(
+                    worldTexture.texture,
+                    Rectangle{0,
+                              0,
+                              static_cast<float>(worldTexture.texture.width),
+                              -static_cast<float>(worldTexture.texture.height)},
+                    window_rectangle,
+                    {0, 0},
+                    0.F,
+                    WHITE);
+            }};
 
         BeginDrawing();
-        rlImGuiBegin();
+        if (debug_interface_loaded)
+        {
+            rlImGuiBegin();
+        }
         ClearBackground(DARKGRAY);
 
-        if (debugMenu)
+        if (resolution_level != 0)
         {
-            BeginTextureMode(gameTexture);
+            BeginTextureMode(worldTextures.get(resolution_level));
             ClearBackground(RAYWHITE);
-            draw_scene(camera,
-                       sphere_position,
-                       constants::kSphereColours[static_cast<size_t>(
-                           selected_sphere_colour)],
-                       font);
+            submit_render_list(camera, render_list, font, RenderPass::World);
+            EndTextureMode();
+        }
+
+        // Captures are taken from the full resolution composite, so compose
+        // into gameTexture whenever it is needed, not just for the debug view
+        const bool compose_game_texture{debugMenu || frame_capture.capturing()};
+        if (compose_game_texture)
+        {
+            BeginTextureMode(gameTexture);
+            draw_world();
+            submit_render_list(camera, render_list, font, RenderPass::Overlay);
             EndTextureMode();
+            frame_capture.capture(gameTexture);
+        }
+
+        if (debugMenu)
+        {
 
             BeginTextureMode(debugTexture);
             DrawTexturePro(gameTexture.texture,
@@ -129,7 +522,19 @@ int main(int /* argc */, char ** /* argv */)
                            RAYWHITE);
             EndTextureMode();
 
-            Game_DrawDebug(selected_sphere_colour);
+            Game_DrawDebug(
+                selected_sphere_colour,
+                FrameStats{dynamic_resolution.scale(),
+                           dynamic_resolution.percentile_frame_time(),
+                           frame_capture.capturing(),
+                           frame_capture.frames_written(),
+                           frame_capture.frames_dropped(),
+                           frame_allocations,
+                           inputRing.overflow_count(),
+                           latencyTracker.summary(),
+                           spawner_system.stats()},
+                physics_engine);
+            body_inspector.draw(physics_engine);
 
             ImGui::Begin(
                 "Jolt raylib Hello World!",
@@ -141,23 +546,137 @@ int main(int /* argc */, char ** /* argv */)
             rlImGuiImageRenderTexture(&debugTexture);
             ImGui::End();
         }
+        else if (compose_game_texture)
+        {
+            DrawTexturePro(gameTexture.texture,
+                           game_source_rectangle,
+                           window_rectangle,
+                           {0, 0},
+                           0.F,
+                           WHITE);
+        }
         else
         {
-            ClearBackground(RAYWHITE);
-            draw_scene(camera,
-                       sphere_position,
-                       constants::kSphereColours[static_cast<size_t>(
-                           selected_sphere_colour)],
-                       font);
+            draw_world();
+            submit_render_list(camera, render_list, font, RenderPass::Overlay);
+        }
+        if (debug_interface_loaded)
+        {
+            rlImGuiEnd();
         }
-        rlImGuiEnd();
         EndDrawing();
 
-        // advance the physics engine one step and get the updated sphere_position
-        physics_engine.update(frame_time, sphere_position);
+        // raylib polls input at the end of EndDrawing, so this is the closest we
+        // can get to when the keys were pressed, and to when the frame was
+        // shown. Drain every queued key, not just the first.
+        const auto input_timestamp{std::chrono::steady_clock::now()};
+        latencyTracker.mark_present(input_timestamp);
+        if (first_frame)
+        {
+            startup_timer.mark_first_frame(input_timestamp);
+            startup_timer.log();
+            first_frame = false;
+        }
+        for (int key{GetKeyPressed()}; key != 0; key = GetKeyPressed())
+        {
+            inputRing.push(InputEvent{key, input_timestamp});
+        }
+
+        // Reloads go here, between the render list job finishing with
+        // sphere_instances and the physics step. Each subsystem only takes
+        // what changed: the world is never rebuilt.
+        file_watcher.poll();
+        if (watch_tuning && file_watcher.take_changed(tuning_watch))
+        {
+            Tuning reloaded{};
+            if (tuning_file::parse_file(options.tuning, reloaded))
+            {
+                if (reloaded.physics != tuning.physics)
+                {
+                    apply_physics_tuning(reloaded.physics, physics_engine);
+                }
+                setup_camera(camera, reloaded);
+                tuning = reloaded;
+                spdlog::info("Tuning reloaded from {}", options.tuning.string());
+            }
+        }
+        if (watch_scene && file_watcher.take_changed(scene_watch))
+        {
+            if (scene_loader.reload(
+                    [&options](SceneSink &sink)
+                    { return scene_parser::parse_file(options.scene, sink); }))
+            {
+                spawner_system.set_spawners(scene_loader.spawners());
+                destructible_system.set_destructibles(
+                    scene_loader.destructibles());
+                sphere_instances.reserve(scene_spheres.size() +
+                                         spawner_system.capacity() +
+                                         destructible_system.capacity());
+            }
+        }
+
+        // Advance the physics engine one step. sphere_position gets the ball's
+        // position after the step, so the frame presented next shows the
+        // result of any kick applied here.
+        if (kickBall)
+        {
+            physics_engine.add_ball_velocity(Vec3{0.F, tuning.kick_speed, 0.F});
+            kickBall = false;
+        }
+        if (explode)
+        {
+            physics_engine.apply_radial_impulse(
+                Vec3{sphere_position.x,
+                     sphere_position.y - constants::kExplosionDepth,
+                     sphere_position.z},
+                constants::kExplosionRadius,
+                constants::kExplosionStrength);
+            explode = false;
+        }
+        spawner_system.update(frame_time);
+        if (physics_engine.update(frame_time, sphere_position))
+        {
+            flight_recorder.record_step(physics_engine);
+            destructible_system.update();
+        }
+        latencyTracker.mark_physics_step();
+
+        kick_render_list_job();
+
+        frame_allocations =
+            allocation_counter::count() - allocations_at_frame_start;
+        ++frame_count;
+        if (options.steady_state && frame_count > kSteadyStateWarmUpFrames &&
+            frame_allocations > 0)
+        {
+            spdlog::warn("Frame {} made {} heap allocations after warm-up",
+                         frame_count,
+                         frame_allocations);
+        }
     }
+    physics_engine.wait_for_job(render_list_job);
+    flight_recorder.close();
+    UnloadFont(font);
+    assets.close();
+    frame_capture.stop();
+    worldTextures.unload();
+    if (debug_interface_loaded)
+    {
+        UnloadRenderTexture(debugTexture);
+        rlImGuiShutdown();
+    }
+
+    const LatencySummary latency{latencyTracker.summary()};
+    spdlog::info("Input to photon latency over {} samples: p50 {:.1f} ms, p95 "
+                 "{:.1f} ms, p99 {:.1f} ms, max {:.1f} ms",
+                 latency.samples,
+                 latency.p50_milliseconds,
+                 latency.p95_milliseconds,
+                 latency.p99_milliseconds,
+                 latency.max_milliseconds);
     spdlog::info("Preparing Physics Engine for Shutdown");
     physics_engine.cleanup();
+    logging::shutdown();
 
     return 0;
 }
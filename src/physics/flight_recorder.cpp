@@ -0,0 +1,115 @@
+#include "flight_recorder.h"
+
+#include "flight_recorder_format.h"
+#include "physics.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Physics/Body/BodyID.h>
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <new>
+
+bool FlightRecorder::open(const std::filesystem::path &path,
+                          const std::size_t capacity)
+{
+    close();
+    if (capacity == 0)
+    {
+        spdlog::error("Flight recorder needs room for at least one record");
+        return false;
+    }
+    const std::size_t size{flight_recorder::kHeaderSize +
+                           capacity * sizeof(flight_recorder::BodyRecord)};
+    if (!_file.create(path, size))
+    {
+        return false;
+    }
+
+    // Start a new recording, even when reusing an old file
+    _header = new (_file.data()) flight_recorder::FileHeader{
+        flight_recorder::kMagic,
+        flight_recorder::kVersion,
+        static_cast<uint32_t>(sizeof(flight_recorder::BodyRecord)),
+        capacity,
+        0,
+        0,
+        0};
+    _records = reinterpret_cast<flight_recorder::BodyRecord *>( // NOLINT
+        _file.data() + flight_recorder::kHeaderSize);
+
+    spdlog::info("Recording body states to {}", path.string());
+    return true;
+}
+
+void FlightRecorder::close()
+{
+    if (!_file.is_open())
+    {
+        return;
+    }
+    _file.flush();
+    _file.close();
+    _header = nullptr;
+    _records = nullptr;
+}
+
+bool FlightRecorder::recording() const
+{
+    return _header != nullptr;
+}
+
+void FlightRecorder::record_step(const PhysicsEngine &physics_engine)
+{
+    if (_header == nullptr)
+    {
+        return;
+    }
+
+    // _active_body_ids keeps its capacity, so this only allocates when more
+    // bodies are awake than ever before
+    physics_engine.get_active_body_ids(_active_body_ids);
+    const uint64_t capacity{_header->capacity};
+    uint64_t write_index{_header->write_index};
+    const auto step{static_cast<uint32_t>(physics_engine.get_step())};
+    for (const JPH::BodyID &body_id : _active_body_ids)
+    {
+        BodyState state{};
+        if (!physics_engine.get_body_state(body_id, state))
+        {
+            continue;
+        }
+        flight_recorder::BodyRecord &record{
+            _records[write_index % capacity]}; // NOLINT
+        record = flight_recorder::BodyRecord{
+            step,
+            state.id.GetIndexAndSequenceNumber(),
+            state.layer,
+            static_cast<uint8_t>(state.motion_type),
+            static_cast<uint8_t>(state.active ? 1 : 0),
+            {static_cast<float>(state.position.GetX()),
+             static_cast<float>(state.position.GetY()),
+             static_cast<float>(state.position.GetZ())},
+            {state.rotation.GetX(),
+             state.rotation.GetY(),
+             state.rotation.GetZ(),
+             state.rotation.GetW()},
+            {state.linear_velocity.GetX(),
+             state.linear_velocity.GetY(),
+             state.linear_velocity.GetZ()},
+            {state.angular_velocity.GetX(),
+             state.angular_velocity.GetY(),
+             state.angular_velocity.GetZ()}};
+        ++write_index;
+    }
+
+    // Publish the step only once its records are in place, so a crash part way
+    // through a step leaves the previous step as the newest complete one
+    std::atomic_thread_fence(std::memory_order_release);
+    _header->write_index = write_index;
+    _header->last_step = step;
+}
@@ -0,0 +1,53 @@
+#ifndef SRC_PHYSICS_FLIGHT_RECORDER_FORMAT_H
+#define SRC_PHYSICS_FLIGHT_RECORDER_FORMAT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// On-disk layout of a flight recorder file, shared by the recorder and the
+// dump tool. The file is a FlightRecorderHeader followed by capacity
+// BodyRecord slots used as a ring. Records are written in place at
+// write_index % capacity and write_index counts every record ever written, so
+// the valid records are the last min(write_index, capacity) of them. A crash
+// part way through a step can leave that step's records in the oldest of those
+// slots before write_index moves on; they are the ones with a step after
+// last_step. Fields are little endian, native layout.
+namespace flight_recorder
+{
+constexpr std::array<char, 8> kMagic{'J', 'R', 'F', 'L', 'I', 'G', 'H', 'T'};
+constexpr uint32_t kVersion{1};
+
+struct FileHeader
+{
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t capacity;
+    // Only advanced once a whole step's records are in place
+    uint64_t write_index;
+    uint32_t last_step;
+    uint32_t reserved;
+};
+
+struct BodyRecord
+{
+    uint32_t step;
+    uint32_t body_id;
+    uint16_t layer;
+    uint8_t motion_type;
+    uint8_t active;
+    std::array<float, 3> position;
+    std::array<float, 4> rotation; // x, y, z, w
+    std::array<float, 3> linear_velocity;
+    std::array<float, 3> angular_velocity;
+};
+
+// Records start on a cache line
+constexpr std::size_t kHeaderSize{64};
+
+static_assert(sizeof(FileHeader) <= kHeaderSize);
+static_assert(sizeof(BodyRecord) == 64);
+} // namespace flight_recorder
+
+#endif
@@ -0,0 +1,918 @@
+// Jolt Physics Library (https://github.com/jrouwe/JoltPhysics)
+// SPDX-FileCopyrightText: 2021 Jorrit Rouwe
+// SPDX-License-Identifier: MIT
+
+#include "physics.h"
+
+#include "allocation_counter.h"
+#include "logging.h"
+
+// The Jolt headers don't include Jolt.h. Always include Jolt.h before including
+// any other Jolt header. You can use Jolt.h in your precompiled header to speed
+// up compilation.
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+// Jolt includes
+#include <Jolt/Core/Color.h>
+#include <Jolt/Core/Core.h>
+#include <Jolt/Core/Factory.h>
+#include <Jolt/Core/IssueReporting.h>
+#include <Jolt/Core/JobSystem.h>
+#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/Memory.h>
+#include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Geometry/AABox.h>
+#include <Jolt/Math/Quat.h>
+#include <Jolt/Math/Real.h>
+#include <Jolt/Math/Vec3.h>
+#include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/Body/BodyActivationListener.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Body/BodyInterface.h>
+#include <Jolt/Physics/Body/BodyLock.h>
+#include <Jolt/Physics/Body/BodyLockInterface.h>
+#include <Jolt/Physics/Body/MotionType.h>
+#include <Jolt/Physics/Collision/BroadPhase/BroadPhaseQuery.h>
+#include <Jolt/Physics/Collision/ContactListener.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/CompoundShape.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+#include <Jolt/Physics/Collision/Shape/SubShapeID.h>
+#include <Jolt/Physics/EActivation.h>
+#include <Jolt/Physics/PhysicsSettings.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/StateRecorder.h>
+#include <Jolt/RegisterTypes.h>
+#include <spdlog/spdlog.h>
+
+// STL includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Disable common warnings triggered by Jolt, you can use
+// JPH_SUPPRESS_WARNING_PUSH / JPH_SUPPRESS_WARNING_POP to store and restore the
+// warning state
+//JPH_SUPPRESS_WARNINGS
+
+// If you want your code to compile using single or double precision write 0.0_r
+// to get a Real value that compiles to double or float depending if
+// JPH_DOUBLE_PRECISION is set or not.
+using namespace JPH::literals;
+
+// Callback for traces, routed to the shared log sink
+static void TraceImpl(const char *inFMT, ...)
+{
+    // Format the message
+    va_list list;
+    va_start(list, inFMT);
+    char buffer[1'024];
+    vsnprintf(buffer, sizeof(buffer), inFMT, list);
+    va_end(list);
+
+    logging::jolt().info(buffer);
+}
+
+#ifdef JPH_ENABLE_ASSERTS
+
+// Callback for asserts, connect this to your own assert handler if you have one
+static bool AssertFailedImpl(const char *inExpression,
+                             const char *inMessage,
+                             const char *inFile,
+                             uint inLine)
+{
+    // Flush before breaking so the message is not left in the async queue
+    logging::jolt().critical("{}:{}: ({}) {}",
+                             inFile,
+                             inLine,
+                             inExpression,
+                             inMessage != nullptr ? inMessage : "");
+    logging::jolt().flush();
+
+    // Breakpoint
+    return true;
+};
+
+#endif // JPH_ENABLE_ASSERTS
+
+// Jolt's default allocator calls malloc directly, which the operator new
+// replacement in allocation_counter.cpp never sees. Wrap the hooks so Jolt's
+// allocations are counted too.
+static JPH::AllocateFunction sDefaultAllocate{nullptr};
+static JPH::AlignedAllocateFunction sDefaultAlignedAllocate{nullptr};
+
+static void *CountingAllocate(size_t inSize)
+{
+    allocation_counter::record();
+    return sDefaultAllocate(inSize);
+}
+
+static void *CountingAlignedAllocate(size_t inSize, size_t inAlignment)
+{
+    allocation_counter::record();
+    return sDefaultAlignedAllocate(inSize, inAlignment);
+}
+
+namespace
+{
+// Appends broad phase hits to a caller's vector, which keeps its capacity
+// between queries, where AllHitCollisionCollector would allocate every time
+class BodyIDCollector final : public JPH::CollideShapeBodyCollector
+{
+public:
+    explicit BodyIDCollector(JPH::BodyIDVector &body_ids)
+        : _body_ids{body_ids}
+    {
+    }
+
+    void AddHit(const JPH::BodyID &inResult) override
+    {
+        _body_ids.push_back(inResult);
+    }
+
+private:
+    JPH::BodyIDVector &_body_ids;
+};
+
+// Only dynamic bodies respond to impulses, and those all live in the moving
+// tree, so queries for them can skip the static tree
+class MovingBroadPhaseFilter final : public JPH::BroadPhaseLayerFilter
+{
+public:
+    [[nodiscard]] bool ShouldCollide(
+        JPH::BroadPhaseLayer inLayer) const override
+    {
+        return inLayer == BroadPhaseLayers::MOVING;
+    }
+};
+
+// Room for this many explosions a step before the queue allocates
+constexpr std::size_t kRadialImpulseReserve{64};
+// A body closer than this to an explosion's centre is pushed straight up
+constexpr float kRadialImpulseMinDistance{1.0e-4F};
+constexpr std::size_t kPairsPerBody{4};
+constexpr std::size_t kContactsPerBody{2};
+constexpr std::size_t kTempBytesPerBody{1'024};
+constexpr std::size_t kMinimumTempBytes{std::size_t{10} * 1'024 * 1'024};
+} // namespace
+
+PhysicsConfig physics_config_for(const std::size_t body_count)
+{
+    PhysicsConfig config{};
+    config.max_bodies = static_cast<JPH::uint>(body_count);
+    config.max_body_pairs = static_cast<JPH::uint>(body_count * kPairsPerBody);
+    config.max_contact_constraints =
+        static_cast<JPH::uint>(body_count * kContactsPerBody);
+    config.temp_allocator_bytes =
+        kMinimumTempBytes + body_count * kTempBytesPerBody;
+    return config;
+}
+
+PhysicsEngine::PhysicsEngine()
+    : _body_activation_listener(std::make_unique<MyBodyActivationListener>()),
+      _contact_listener(std::make_unique<MyContactListener>())
+{
+}
+
+void PhysicsEngine::initialise(const PhysicsConfig &config)
+{
+    // Register allocation hook. In this example we'll just let Jolt use malloc /
+    // free but you can override these if you want (see Memory.h). This needs to
+    // be done before any other Jolt function is called.
+    JPH::RegisterDefaultAllocator();
+    sDefaultAllocate = JPH::Allocate;
+    sDefaultAlignedAllocate = JPH::AlignedAllocate;
+    JPH::Allocate = CountingAllocate;
+    JPH::AlignedAllocate = CountingAlignedAllocate;
+
+    // Install trace and assert callbacks
+    JPH::Trace = TraceImpl;
+    JPH_IF_ENABLE_ASSERTS(AssertFailed = AssertFailedImpl;)
+
+    // Create a factory, this class is responsible for creating instances of
+    // classes based on their name or hash and is mainly used for deserialization
+    // of saved data. It is not directly used in this example but still required.
+    JPH::Factory::sInstance = new JPH::Factory();
+
+    // Register all physics types with the factory and install their collision
+    // handlers with the CollisionDispatch class. If you have your own custom
+    // shape types you probably need to register their handlers with the
+    // CollisionDispatch before calling this function. If you implement your own
+    // default material (PhysicsMaterial::sDefault) make sure to initialize it
+    // before this function or else this function will create one for you.
+    JPH::RegisterTypes();
+
+    // We need a temp allocator for temporary allocations during the physics
+    // update. We're pre-allocating 10 MB to avoid having to do allocations during
+    // the physics update. B.t.w. 10 MB is way too much for this example but it is
+    // a typical value you can use. If you don't want to pre-allocate you can also
+    // use TempAllocatorMalloc to fall back to malloc / free.
+    _temp_allocator =
+        std::make_unique<JPH::TempAllocatorImpl>(config.temp_allocator_bytes);
+
+    // We need a job system that will execute physics jobs on multiple threads.
+    // Typically you would implement the JobSystem interface yourself and let Jolt
+    // Physics run on top of your own job scheduler. JobSystemThreadPool is an
+    // example implementation.
+    const int worker_threads{
+        config.worker_threads >= 0
+            ? config.worker_threads
+            : static_cast<int>(std::thread::hardware_concurrency()) - 1};
+    _job_system = std::make_unique<JPH::JobSystemThreadPool>(
+        JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, worker_threads);
+
+    // This is the max amount of rigid bodies that you can add to the physics
+    // system. If you try to add more you'll get an error. Note: The default is
+    // low because this is a simple test. For a real project use something in
+    // the order of 65536.
+    const JPH::uint cMaxBodies{config.max_bodies};
+
+    // This determines how many mutexes to allocate to protect rigid bodies from
+    // concurrent access. Set it to 0 for the default settings.
+    constexpr JPH::uint cNumBodyMutexes = 0;
+
+    // This is the max amount of body pairs that can be queued at any time (the
+    // broad phase will detect overlapping body pairs based on their bounding
+    // boxes and will insert them into a queue for the narrowphase). If you make
+    // this buffer too small the queue will fill up and the broad phase jobs will
+    // start to do narrow phase work. This is slightly less efficient. Note: The
+    // default is low because this is a simple test. For a real project use
+    // something in the order of 65536.
+    const JPH::uint cMaxBodyPairs{config.max_body_pairs};
+
+    // This is the maximum size of the contact constraint buffer. If more contacts
+    // (collisions between bodies) are detected than this number then these
+    // contacts will be ignored and bodies will start interpenetrating / fall
+    // through the world. Note: The default is low because this is a simple
+    // test. For a real project use something in the order of 10240.
+    const JPH::uint cMaxContactConstraints{config.max_contact_constraints};
+
+    // Create mapping table from object layer to broadphase layer
+    // Note: As this is an interface, PhysicsSystem will take a reference to this
+    // so this instance needs to stay alive!
+    _broad_phase_layer_interface = std::make_unique<BPLayerInterfaceImpl>();
+
+    // Create class that filters object vs broadphase layers
+    // Note: As this is an interface, PhysicsSystem will take a reference to this
+    // so this instance needs to stay alive!
+    _object_vs_broadphase_layer_filter =
+        std::make_unique<ObjectVsBroadPhaseLayerFilterImpl>();
+
+    // Create class that filters object vs object layers
+    // Note: As this is an interface, PhysicsSystem will take a reference to this
+    // so this instance needs to stay alive!
+    _object_vs_object_layer_filter =
+        std::make_unique<ObjectLayerPairFilterImpl>();
+
+    // Now we can create the actual physics system.
+    _physics_system = std::make_unique<JPH::PhysicsSystem>();
+    _physics_system->Init(cMaxBodies,
+                          cNumBodyMutexes,
+                          cMaxBodyPairs,
+                          cMaxContactConstraints,
+                          *_broad_phase_layer_interface,
+                          *_object_vs_broadphase_layer_filter,
+                          *_object_vs_object_layer_filter);
+
+    // A body activation listener gets notified when bodies activate and go to
+    // sleep Note that this is called from a job so whatever you do here needs to
+    // be thread safe. Registering one is entirely optional.
+    _physics_system->SetBodyActivationListener(_body_activation_listener.get());
+
+    // A contact listener gets notified when bodies (are about to) collide, and
+    // when they separate again. Note that this is called from a job so whatever
+    // you do here needs to be thread safe. Registering one is entirely optional.
+    _physics_system->SetContactListener(_contact_listener.get());
+    _compound_impacts.reserve(MyContactListener::kMaxCompoundImpacts);
+    _radial_impulses.reserve(kRadialImpulseReserve);
+    _impulse_body_ids.reserve(cMaxBodies);
+    _wake_body_ids.reserve(cMaxBodies);
+    _active_body_ids.reserve(cMaxBodies);
+    _energy_body_ids.reserve(cMaxBodies);
+
+    // The main way to interact with the bodies in the physics system is through
+    // the body interface. There is a locking and a non-locking variant of this.
+    // We're going to use the locking version (even though we're not planning to
+    // access bodies from multiple threads)
+    //JPH::BodyInterface &body_interface = _physics_system->GetBodyInterface();
+}
+
+void PhysicsEngine::create_floor(const Vec3 &floor_dimensions,
+                                 const Vec3 &floor_position)
+{
+    // Next we can create a rigid body to serve as the floor, we make a large box
+    // Create the settings for the collision volume (the shape).
+    // Note that for simple shapes (like boxes) you can also directly construct a
+    // BoxShape.
+    const JPH::BoxShapeSettings floor_shape_settings{
+        //JPH::Vec3(100.F, 1.F, 100.F)};
+        JPH::Vec3{floor_dimensions.x, floor_dimensions.y, floor_dimensions.z}};
+
+    // Create the shape
+    const JPH::ShapeSettings::ShapeResult floor_shape_result =
+        floor_shape_settings.Create();
+    const JPH::ShapeRefC floor_shape =
+        floor_shape_result
+            .Get(); // We don't expect an error here, but you can check
+                    // floor_shape_result for HasError() / GetError()
+
+    if (floor_shape_result.HasError())
+    {
+        spdlog::error("Error creating floor: {}",
+                      floor_shape_result.GetError());
+    }
+
+    // Create the settings for the body itself. Note that here you can also set
+    // other properties like the restitution / friction.
+    const JPH::BodyCreationSettings floor_settings(
+        floor_shape,
+        //JPH::RVec3(0.0_r, -1.0_r, 0.0_r),
+        JPH::RVec3(floor_position.x, floor_position.y, floor_position.z),
+        JPH::Quat::sIdentity(),
+        JPH::EMotionType::Static,
+        Layers::NON_MOVING);
+
+    JPH::BodyInterface &body_interface = _physics_system->GetBodyInterface();
+
+    // Create the actual rigid body
+    JPH::Body *floor = body_interface.CreateBody(
+        floor_settings); // Note that if we run out of bodies this can return
+                         // nullptr
+    if (floor == nullptr)
+    {
+        spdlog::error("Error creating floor body interface. Thre might be too "
+                      "many bodies.");
+    }
+
+    // Add it to the world
+    body_interface.AddBody(floor->GetID(), JPH::EActivation::DontActivate);
+
+    _floor_id = floor->GetID();
+    //body_interface.SetFriction(_floor_id, 1.F);
+}
+
+void PhysicsEngine::create_ball(const float ball_radius,
+                                const Vec3 &ball_position,
+                                const Vec3 &ball_velocity)
+{
+    _sphere_id = add_ball(ball_radius, ball_position, ball_velocity);
+}
+
+JPH::BodyID PhysicsEngine::add_ball(const float ball_radius,
+                                    const Vec3 &ball_position,
+                                    const Vec3 &ball_velocity)
+{
+    // Now create a dynamic body to bounce on the floor. Setting the velocity and
+    // restitution on the settings, rather than on the body after adding it,
+    // avoids locking the body three times.
+    JPH::BodyCreationSettings sphere_settings(
+        new JPH::SphereShape(ball_radius),
+        JPH::RVec3(ball_position.x, ball_position.y, ball_position.z),
+        JPH::Quat::sIdentity(),
+        JPH::EMotionType::Dynamic,
+        Layers::MOVING);
+    sphere_settings.mLinearVelocity =
+        JPH::Vec3(ball_velocity.x, ball_velocity.y, ball_velocity.z);
+    sphere_settings.mRestitution = 0.8F;
+    JPH::BodyInterface &body_interface = _physics_system->GetBodyInterface();
+    return body_interface.CreateAndAddBody(sphere_settings,
+                                           JPH::EActivation::Activate);
+}
+
+void PhysicsEngine::add_bodies(
+    const std::vector<JPH::BodyCreationSettings> &settings,
+    JPH::BodyIDVector &body_ids)
+{
+    JPH::BodyInterface &body_interface{_physics_system->GetBodyInterface()};
+    body_ids.clear();
+    body_ids.reserve(settings.size());
+    _batch_body_ids.clear();
+    for (const JPH::BodyCreationSettings &body_settings : settings)
+    {
+        const JPH::Body *body{body_interface.CreateBody(body_settings)};
+        if (body == nullptr)
+        {
+            body_ids.push_back(JPH::BodyID{});
+            continue;
+        }
+        body_ids.push_back(body->GetID());
+        _batch_body_ids.push_back(body->GetID());
+    }
+    if (_batch_body_ids.size() < settings.size())
+    {
+        spdlog::warn("{} of {} bodies not created, the world is full",
+                     settings.size() - _batch_body_ids.size(),
+                     settings.size());
+    }
+    if (_batch_body_ids.empty())
+    {
+        return;
+    }
+
+    // Prepare sorts the IDs it is given, which is why it gets a scratch copy
+    // rather than body_ids. Static bodies are never activated.
+    const int count{static_cast<int>(_batch_body_ids.size())};
+    const JPH::BodyInterface::AddState add_state{
+        body_interface.AddBodiesPrepare(_batch_body_ids.data(), count)};
+    body_interface.AddBodiesFinalize(_batch_body_ids.data(),
+                                     count,
+                                     add_state,
+                                     JPH::EActivation::Activate);
+}
+
+void PhysicsEngine::remove_bodies(JPH::BodyIDVector &body_ids)
+{
+    if (body_ids.empty())
+    {
+        return;
+    }
+    for (const JPH::BodyID &body_id : body_ids)
+    {
+        if (body_id == _sphere_id)
+        {
+            _sphere_id = JPH::BodyID{};
+        }
+        if (body_id == _floor_id)
+        {
+            _floor_id = JPH::BodyID{};
+        }
+    }
+
+    JPH::BodyInterface &body_interface{_physics_system->GetBodyInterface()};
+    const int count{static_cast<int>(body_ids.size())};
+    body_interface.RemoveBodies(body_ids.data(), count);
+    body_interface.DestroyBodies(body_ids.data(), count);
+}
+
+void PhysicsEngine::set_ball(const JPH::BodyID &body_id)
+{
+    _sphere_id = body_id;
+}
+
+void PhysicsEngine::destroy_body(const JPH::BodyID &body_id)
+{
+    // Removing a body from the world keeps its state, destroying it frees the
+    // ID for reuse
+    JPH::BodyInterface &body_interface{_physics_system->GetBodyInterface()};
+    body_interface.RemoveBody(body_id);
+    body_interface.DestroyBody(body_id);
+}
+
+void PhysicsEngine::set_shape(const JPH::BodyID &body_id,
+                              const JPH::Shape *shape,
+                              const bool update_mass)
+{
+    // Jolt moves the body by the change in centre of mass, so the parts that
+    // are left stay where they were
+    JPH::BodyInterface &body_interface{_physics_system->GetBodyInterface()};
+    body_interface.SetShape(
+        body_id, shape, update_mass, JPH::EActivation::Activate);
+}
+
+void PhysicsEngine::add_ball_velocity(const Vec3 &velocity)
+{
+    // A velocity change rather than an impulse, so callers do not need to know
+    // the ball's mass. This also wakes the ball up if it has gone to sleep.
+    if (_sphere_id.IsInvalid())
+    {
+        return;
+    }
+    JPH::BodyInterface &body_interface{_physics_system->GetBodyInterface()};
+    body_interface.AddLinearVelocity(
+        _sphere_id, JPH::Vec3{velocity.x, velocity.y, velocity.z});
+}
+
+void PhysicsEngine::apply_radial_impulse(const Vec3 &centre,
+                                         const float radius,
+                                         const float strength,
+                                         const float falloff)
+{
+    if (radius <= 0.F)
+    {
+        return;
+    }
+    _radial_impulses.push_back(RadialImpulse{
+        JPH::Vec3{centre.x, centre.y, centre.z}, radius, strength, falloff});
+}
+
+void PhysicsEngine::apply_radial_impulses()
+{
+    if (_radial_impulses.empty())
+    {
+        return;
+    }
+
+    // One broad phase query finds the candidates for every queued explosion.
+    // A lone explosion uses its sphere, several use the box around them all.
+    _impulse_body_ids.clear();
+    BodyIDCollector collector{_impulse_body_ids};
+    const MovingBroadPhaseFilter broad_phase_filter{};
+    const JPH::BroadPhaseQuery &query{_physics_system->GetBroadPhaseQuery()};
+    if (_radial_impulses.size() == 1)
+    {
+        const RadialImpulse &explosion{_radial_impulses.front()};
+        query.CollideSphere(
+            explosion.centre, explosion.radius, collector, broad_phase_filter);
+    }
+    else
+    {
+        JPH::AABox bounds{};
+        for (const RadialImpulse &explosion : _radial_impulses)
+        {
+            const JPH::Vec3 extent{JPH::Vec3::sReplicate(explosion.radius)};
+            bounds.Encapsulate(JPH::AABox{explosion.centre - extent,
+                                          explosion.centre + extent});
+        }
+        query.CollideAABox(bounds, collector, broad_phase_filter);
+    }
+
+    // Only called between steps on the main thread, so bodies are written
+    // without locking. Each body gets the sum of its explosions as one
+    // impulse, and sleeping ones are woken together afterwards.
+    const JPH::BodyLockInterfaceNoLock &lock_interface{
+        _physics_system->GetBodyLockInterfaceNoLock()};
+    _wake_body_ids.clear();
+    for (const JPH::BodyID &body_id : _impulse_body_ids)
+    {
+        const JPH::BodyLockWrite lock{lock_interface, body_id};
+        if (!lock.Succeeded() || !lock.GetBody().IsDynamic())
+        {
+            continue;
+        }
+        JPH::Body &body{lock.GetBody()};
+        const JPH::Vec3 position{body.GetCenterOfMassPosition()};
+
+        JPH::Vec3 impulse{JPH::Vec3::sZero()};
+        for (const RadialImpulse &explosion : _radial_impulses)
+        {
+            const JPH::Vec3 offset{position - explosion.centre};
+            const float distance{offset.Length()};
+            if (distance >= explosion.radius)
+            {
+                continue;
+            }
+            const JPH::Vec3 direction{distance > kRadialImpulseMinDistance
+                                          ? offset / distance
+                                          : JPH::Vec3::sAxisY()};
+            impulse += direction * explosion.strength *
+                       std::pow(1.F - distance / explosion.radius,
+                                explosion.falloff);
+        }
+        if (impulse.IsNearZero())
+        {
+            continue;
+        }
+        body.AddImpulse(impulse);
+        if (!body.IsActive())
+        {
+            _wake_body_ids.push_back(body_id);
+        }
+    }
+    if (!_wake_body_ids.empty())
+    {
+        _physics_system->GetBodyInterfaceNoLock().ActivateBodies(
+            _wake_body_ids.data(), static_cast<int>(_wake_body_ids.size()));
+    }
+    _radial_impulses.clear();
+}
+
+void PhysicsEngine::start_simulation()
+{
+    _physics_system->OptimizeBroadPhase();
+}
+
+bool PhysicsEngine::update(const float cDeltaTime, Vec3 &sphere_position)
+{
+    // Once everything is asleep stepping would change nothing, unless an
+    // explosion queued for the step is about to wake something
+    if (_radial_impulses.empty() &&
+        _physics_system->GetNumActiveBodies(JPH::EBodyType::RigidBody) == 0)
+    {
+        SPDLOG_DEBUG("No bodies are active");
+        return false;
+    }
+    step(cDeltaTime);
+    if (_sphere_id.IsInvalid())
+    {
+        return true;
+    }
+
+    const JPH::BodyInterface &body_interface{
+        _physics_system->GetBodyInterface()};
+
+    // Output the sphere's position and velocity after the step, so what is
+    // drawn next is the state the step just produced
+    const JPH::RVec3 position{
+        body_interface.GetCenterOfMassPosition(_sphere_id)};
+    const JPH::Vec3 velocity{body_interface.GetLinearVelocity(_sphere_id)};
+    SPDLOG_TRACE("Step {}: Position = ({:.2f}, {:.2f}, {:.2f}), Velocity = "
+                 "({:.2f}, {:.2f}, {:.2f})",
+                 _step,
+                 position.GetX(),
+                 position.GetY(),
+                 position.GetZ(),
+                 velocity.GetX(),
+                 velocity.GetY(),
+                 velocity.GetZ());
+
+    sphere_position =
+        Vec3{position.GetX(), position.GetY(), position.GetZ()};
+    return true;
+}
+
+void PhysicsEngine::step(const float delta_time)
+{
+    ++_step;
+    apply_radial_impulses();
+
+    // If you take larger steps than 1 / 60th of a second you need to do
+    // multiple collision steps in order to keep the simulation stable. Do 1
+    // collision step per 1 / 60th of a second (round up).
+    constexpr int cCollisionSteps{1};
+
+    // Step the world, reusing the temp allocator made in initialise so a step
+    // does not need any heap allocations
+    const auto step_start{std::chrono::steady_clock::now()};
+    _physics_system->Update(delta_time,
+                            cCollisionSteps,
+                            _temp_allocator.get(),
+                            _job_system.get());
+    _contact_listener->take_impacts(_compound_impacts);
+    record_step_stats(std::chrono::duration<float, std::milli>(
+                          std::chrono::steady_clock::now() - step_start)
+                          .count());
+}
+
+void PhysicsEngine::save_state(JPH::StateRecorder &recorder) const
+{
+    _physics_system->SaveState(recorder);
+}
+
+bool PhysicsEngine::restore_state(JPH::StateRecorder &recorder)
+{
+    return _physics_system->RestoreState(recorder);
+}
+
+void PhysicsEngine::record_step_stats(const float step_milliseconds)
+{
+    const std::size_t index{_step_stats.next};
+    _step_stats.step_milliseconds.at(index) = step_milliseconds;
+    _step_stats.max_penetration.at(index) =
+        _contact_listener->take_max_penetration();
+    _step_stats.energy_change.at(index) = compute_energy_change();
+    _step_stats.next = (index + 1) % StepStatsHistory::kLength;
+}
+
+float PhysicsEngine::compute_energy_change()
+{
+    // The change is measured over the bodies that were moving last step, so a
+    // body falling asleep or waking up does not show up as energy appearing or
+    // vanishing. GetActiveBodies gives no particular order, so sort to compare
+    // the sets.
+    _physics_system->GetActiveBodies(JPH::EBodyType::RigidBody,
+                                     _active_body_ids);
+    std::sort(_active_body_ids.begin(), _active_body_ids.end());
+    bool complete{true};
+    float energy_change{0.F};
+    float energy{0.F};
+    if (_active_body_ids == _energy_body_ids)
+    {
+        energy = compute_body_energy(_active_body_ids, complete);
+        energy_change = energy - _last_energy;
+    }
+    else
+    {
+        // A removed body has no energy to compare, so skip the step
+        const float previous_set_energy{
+            compute_body_energy(_energy_body_ids, complete)};
+        if (complete)
+        {
+            energy_change = previous_set_energy - _last_energy;
+        }
+        energy = compute_body_energy(_active_body_ids, complete);
+        _energy_body_ids.swap(_active_body_ids);
+    }
+    const float last_energy{_last_energy};
+    _last_energy = energy;
+
+    // Potential energy is measured from the origin, so the total can sit near
+    // zero while the bodies are moving. Flooring the denominator stops that
+    // showing up as a huge relative change.
+    constexpr float kMinEnergyScale{1.F}; // J
+    return energy_change / std::max(std::fabs(last_energy), kMinEnergyScale);
+}
+
+float PhysicsEngine::compute_body_energy(const JPH::BodyIDVector &body_ids,
+                                         bool &complete) const
+{
+    // Kinetic plus gravitational potential energy of the dynamic bodies.
+    // complete is set to false if any of the bodies no longer exists.
+    const JPH::Vec3 gravity{_physics_system->GetGravity()};
+    const JPH::BodyLockInterfaceNoLock &lock_interface{
+        _physics_system->GetBodyLockInterfaceNoLock()};
+
+    float energy{0.F};
+    complete = true;
+    for (const JPH::BodyID &body_id : body_ids)
+    {
+        const JPH::BodyLockRead lock{lock_interface, body_id};
+        if (!lock.Succeeded())
+        {
+            complete = false;
+            continue;
+        }
+        if (!lock.GetBody().IsDynamic())
+        {
+            continue;
+        }
+        const JPH::Body &body{lock.GetBody()};
+        const float inverse_mass{body.GetMotionProperties()->GetInverseMass()};
+        if (inverse_mass == 0.F)
+        {
+            continue;
+        }
+        const float mass{1.F / inverse_mass};
+        const JPH::Vec3 position{body.GetCenterOfMassPosition()};
+        energy += 0.5F * mass * body.GetLinearVelocity().LengthSq() -
+                  mass * gravity.Dot(position);
+    }
+    return energy;
+}
+
+const JPH::PhysicsSettings &PhysicsEngine::get_physics_settings() const
+{
+    return _physics_system->GetPhysicsSettings();
+}
+
+void PhysicsEngine::set_physics_settings(
+    const JPH::PhysicsSettings &physics_settings)
+{
+    _physics_system->SetPhysicsSettings(physics_settings);
+}
+
+void PhysicsEngine::set_gravity(const Vec3 &gravity)
+{
+    _physics_system->SetGravity(JPH::Vec3{gravity.x, gravity.y, gravity.z});
+}
+
+const StepStatsHistory &PhysicsEngine::get_step_stats_history() const
+{
+    return _step_stats;
+}
+
+const std::vector<CompoundImpact> &PhysicsEngine::get_compound_impacts() const
+{
+    return _compound_impacts;
+}
+
+JPH::JobHandle PhysicsEngine::create_job(
+    const char *name,
+    const JPH::JobSystem::JobFunction &job_function)
+{
+    return _job_system->CreateJob(name, JPH::Color::sCyan, job_function);
+}
+
+void PhysicsEngine::wait_for_job(const JPH::JobHandle &job)
+{
+    // Barriers are the job system's only blocking primitive. While waiting, the
+    // calling thread picks up queued jobs itself, so this also works when the
+    // pool has no worker threads.
+    JPH::JobSystem::Barrier *barrier{_job_system->CreateBarrier()};
+    barrier->AddJob(job);
+    _job_system->WaitForJobs(barrier);
+    _job_system->DestroyBarrier(barrier);
+}
+
+JPH::uint PhysicsEngine::get_step() const
+{
+    return _step;
+}
+
+JPH::uint PhysicsEngine::get_num_bodies() const
+{
+    return _physics_system->GetNumBodies();
+}
+
+void PhysicsEngine::get_body_ids(JPH::BodyIDVector &body_ids) const
+{
+    _physics_system->GetBodies(body_ids);
+}
+
+void PhysicsEngine::get_active_body_ids(JPH::BodyIDVector &body_ids) const
+{
+    _physics_system->GetActiveBodies(JPH::EBodyType::RigidBody, body_ids);
+}
+
+bool PhysicsEngine::get_body_state(const JPH::BodyID &body_id,
+                                   BodyState &body_state) const
+{
+    const JPH::BodyLockRead lock{_physics_system->GetBodyLockInterfaceNoLock(),
+                                 body_id};
+    if (!lock.Succeeded())
+    {
+        return false;
+    }
+
+    const JPH::Body &body{lock.GetBody()};
+    body_state = BodyState{body.GetID(),
+                           body.GetObjectLayer(),
+                           body.GetMotionType(),
+                           body.GetPosition(),
+                           body.GetRotation(),
+                           body.GetLinearVelocity(),
+                           body.GetAngularVelocity(),
+                           body.IsActive()};
+    return true;
+}
+
+bool PhysicsEngine::get_body_position(const JPH::BodyID &body_id,
+                                      Vec3 &position) const
+{
+    const JPH::BodyLockRead lock{_physics_system->GetBodyLockInterfaceNoLock(),
+                                 body_id};
+    if (!lock.Succeeded())
+    {
+        return false;
+    }
+
+    const JPH::RVec3 body_position{lock.GetBody().GetPosition()};
+    position = Vec3{static_cast<float>(body_position.GetX()),
+                    static_cast<float>(body_position.GetY()),
+                    static_cast<float>(body_position.GetZ())};
+    return true;
+}
+
+bool PhysicsEngine::get_sub_shape_user_data(const JPH::BodyID &body_id,
+                                            const JPH::SubShapeID &sub_shape_id,
+                                            JPH::uint64 &user_data) const
+{
+    const JPH::BodyLockRead lock{_physics_system->GetBodyLockInterfaceNoLock(),
+                                 body_id};
+    if (!lock.Succeeded())
+    {
+        return false;
+    }
+
+    const JPH::Body &body{lock.GetBody()};
+    const JPH::Shape *shape{body.GetShape()};
+    if (shape->GetType() != JPH::EShapeType::Compound)
+    {
+        user_data = body.GetUserData();
+        return true;
+    }
+    const auto *compound{static_cast<const JPH::CompoundShape *>(shape)};
+    JPH::SubShapeID remainder{};
+    const JPH::uint index{
+        compound->GetSubShapeIndexFromID(sub_shape_id, remainder)};
+    user_data = compound->GetSubShape(index).mUserData;
+    return true;
+}
+
+void PhysicsEngine::get_bodies_in_box(const Vec3 &min,
+                                      const Vec3 &max,
+                                      JPH::BodyIDVector &body_ids) const
+{
+    body_ids.clear();
+    BodyIDCollector collector{body_ids};
+    _physics_system->GetBroadPhaseQuery().CollideAABox(
+        JPH::AABox{JPH::Vec3{min.x, min.y, min.z},
+                   JPH::Vec3{max.x, max.y, max.z}},
+        collector);
+}
+
+void PhysicsEngine::cleanup()
+{
+    JPH::BodyInterface &body_interface{_physics_system->GetBodyInterface()};
+
+    // Remove the sphere from the physics system. Note that the sphere itself
+    // keeps all of its state and can be re-added at any time. Then destroy it,
+    // after which the sphere ID is no longer valid. Scenes without a ball or
+    // floor leave the IDs invalid. Any other bodies are destroyed along with
+    // the physics system.
+    if (!_sphere_id.IsInvalid())
+    {
+        body_interface.RemoveBody(_sphere_id);
+        body_interface.DestroyBody(_sphere_id);
+    }
+
+    // Remove and destroy the floor
+    if (!_floor_id.IsInvalid())
+    {
+        body_interface.RemoveBody(_floor_id);
+        body_interface.DestroyBody(_floor_id);
+    }
+
+    // Unregisters all types with the factory and cleans up the default material
+    JPH::UnregisterTypes();
+
+    // Destroy the factory
+    delete JPH::Factory::sInstance;
+    JPH::Factory::sInstance = nullptr;
+}
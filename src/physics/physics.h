@@ -0,0 +1,500 @@
+#ifndef SRC_PHYSICS_PHYSICS_H
+#define SRC_PHYSICS_PHYSICS_H
+
+#include "vec3.h"
+
+// The Jolt headers don't include Jolt.h. Always include Jolt.h before including
+// any other Jolt header. You can use Jolt.h in your precompiled header to speed
+// up compilation.
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+// Jolt includes
+#include <Jolt/Core/Core.h>
+#include <Jolt/Core/IssueReporting.h>
+#include <Jolt/Core/JobSystem.h>
+#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Math/Real.h>
+#include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/Body/BodyActivationListener.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Body/MotionType.h>
+#include <Jolt/Physics/Collision/BroadPhase/BroadPhaseLayer.h>
+#include <Jolt/Physics/Collision/ContactListener.h>
+#include <Jolt/Physics/Collision/ObjectLayer.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+#include <Jolt/Physics/Collision/Shape/SubShapeID.h>
+#include <Jolt/Physics/Collision/Shape/SubShapeIDPair.h>
+#include <Jolt/Physics/PhysicsSettings.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/StateRecorder.h>
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Layer that objects can be in, determines which other objects it can collide
+// with Typically you at least want to have 1 layer for moving bodies and 1
+// layer for static bodies, but you can have more layers if you want. E.g. you
+// could have a layer for high detail collision (which is not used by the
+// physics simulation but only if you do collision testing).
+namespace Layers
+{
+static constexpr JPH::ObjectLayer NON_MOVING{0};
+static constexpr JPH::ObjectLayer MOVING{1};
+static constexpr JPH::ObjectLayer NUM_LAYERS{2};
+}; // namespace Layers
+
+/// Class that determines if two object layers can collide
+class ObjectLayerPairFilterImpl : public JPH::ObjectLayerPairFilter
+{
+public:
+    [[nodiscard]] bool ShouldCollide(JPH::ObjectLayer inObject1,
+                                     JPH::ObjectLayer inObject2) const override
+    {
+        switch (inObject1)
+        {
+        case Layers::NON_MOVING:
+            return inObject2 ==
+                   Layers::MOVING; // Non moving only collides with moving
+        case Layers::MOVING:
+            return true; // Moving collides with everything
+        default:
+            JPH_ASSERT(false);
+            return false;
+        }
+    }
+};
+
+// Each broadphase layer results in a separate bounding volume tree in the broad
+// phase. You at least want to have a layer for non-moving and moving objects to
+// avoid having to update a tree full of static objects every frame. You can
+// have a 1-on-1 mapping between object layers and broadphase layers (like in
+// this case) but if you have many object layers you'll be creating many broad
+// phase trees, which is not efficient. If you want to fine tune your broadphase
+// layers define JPH_TRACK_BROADPHASE_STATS and look at the stats reported on
+// the TTY.
+namespace BroadPhaseLayers
+{
+static constexpr JPH::BroadPhaseLayer NON_MOVING(0);
+static constexpr JPH::BroadPhaseLayer MOVING(1);
+static constexpr JPH::uint NUM_LAYERS(2);
+}; // namespace BroadPhaseLayers
+
+// BroadPhaseLayerInterface implementation
+// This defines a mapping between object and broadphase layers.
+class BPLayerInterfaceImpl final : public JPH::BroadPhaseLayerInterface
+{
+public:
+    BPLayerInterfaceImpl()
+    {
+        // Create a mapping table from object to broad phase layer
+        mObjectToBroadPhase[Layers::NON_MOVING] = BroadPhaseLayers::NON_MOVING;
+        mObjectToBroadPhase[Layers::MOVING] = BroadPhaseLayers::MOVING;
+    }
+
+    [[nodiscard]] JPH::uint GetNumBroadPhaseLayers() const override
+    {
+        return BroadPhaseLayers::NUM_LAYERS;
+    }
+
+    [[nodiscard]] JPH::BroadPhaseLayer GetBroadPhaseLayer(
+        JPH::ObjectLayer inLayer) const override
+    {
+        JPH_ASSERT(inLayer < Layers::NUM_LAYERS);
+        return mObjectToBroadPhase[inLayer];
+    }
+
+#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
+    virtual const char *GetBroadPhaseLayerName(
+        JPH::BroadPhaseLayer inLayer) const override
+    {
+        switch ((JPH::BroadPhaseLayer::Type)inLayer)
+        {
+        case (JPH::BroadPhaseLayer::Type)BroadPhaseLayers::NON_MOVING:
+            return "NON_MOVING";
+        case (JPH::BroadPhaseLayer::Type)BroadPhaseLayers::MOVING:
+            return "MOVING";
+        default:
+            JPH_ASSERT(false);
+            return "INVALID";
+        }
+    }
+#endif // JPH_EXTERNAL_PROFILE || JPH_PROFILE_ENABLED
+
+private:
+    JPH::BroadPhaseLayer mObjectToBroadPhase[Layers::NUM_LAYERS];
+    //std::array<JPH::BroadPhaseLayer, Layers::NUM_LAYERS> mObjectToBroadPhase;
+};
+
+/// Class that determines if an object layer can collide with a broadphase layer
+class ObjectVsBroadPhaseLayerFilterImpl
+    : public JPH::ObjectVsBroadPhaseLayerFilter
+{
+public:
+    [[nodiscard]] bool ShouldCollide(
+        JPH::ObjectLayer inLayer1,
+        JPH::BroadPhaseLayer inLayer2) const override
+    {
+        switch (inLayer1)
+        {
+        case Layers::NON_MOVING:
+            return inLayer2 == BroadPhaseLayers::MOVING;
+        case Layers::MOVING:
+            return true;
+        default:
+            JPH_ASSERT(false);
+            return false;
+        }
+    }
+};
+
+// A new contact on a MutableCompoundShape body, and the part it touched
+struct CompoundImpact
+{
+    JPH::BodyID body_id;
+    JPH::SubShapeID sub_shape_id;
+    float impulse; // N s
+};
+
+// An example contact listener
+class MyContactListener : public JPH::ContactListener
+{
+public:
+    // Impacts past this many in one step are dropped
+    static constexpr std::size_t kMaxCompoundImpacts{1'024};
+
+    MyContactListener() : _impacts(kMaxCompoundImpacts)
+    {
+    }
+
+    // See: ContactListener
+    JPH::ValidateResult OnContactValidate(
+        const JPH::Body & /* inBody1 */,
+        const JPH::Body & /* inBody2 */,
+        JPH::RVec3Arg /* inBaseOffset */,
+        const JPH::CollideShapeResult & /* inCollisionResult */) override
+    {
+        SPDLOG_TRACE("Contact validate callback");
+
+        // Allows you to ignore a contact before it is created (using layers to not
+        // make objects collide is cheaper!)
+        return JPH::ValidateResult::AcceptAllContactsForThisBodyPair;
+    }
+
+    void OnContactAdded(const JPH::Body &inBody1,
+                        const JPH::Body &inBody2,
+                        const JPH::ContactManifold &inManifold,
+                        JPH::ContactSettings & /* ioSettings */) override
+    {
+        SPDLOG_TRACE("A contact was added");
+        record_penetration(inManifold.mPenetrationDepth);
+        record_impact(inBody1, inBody2, inManifold);
+    }
+
+    void OnContactPersisted(const JPH::Body & /* inBody1 */,
+                            const JPH::Body & /* inBody2 */,
+                            const JPH::ContactManifold &inManifold,
+                            JPH::ContactSettings & /* ioSettings */) override
+    {
+        SPDLOG_TRACE("A contact was persisted");
+        record_penetration(inManifold.mPenetrationDepth);
+    }
+
+    void OnContactRemoved(
+        const JPH::SubShapeIDPair & /* inSubShapePair */) override
+    {
+        SPDLOG_TRACE("A contact was removed");
+    }
+
+    // Deepest penetration seen since the last call, resets the running maximum
+    float take_max_penetration()
+    {
+        return _max_penetration.exchange(0.F);
+    }
+
+    // Copies out the impacts recorded since the last call and starts again.
+    // impacts should have room for kMaxCompoundImpacts, so this never
+    // allocates.
+    void take_impacts(std::vector<CompoundImpact> &impacts)
+    {
+        const std::size_t count{std::min(_impact_count.exchange(0),
+                                         _impacts.size())};
+        impacts.assign(_impacts.begin(),
+                       _impacts.begin() +
+                           static_cast<std::ptrdiff_t>(count));
+    }
+
+private:
+    static bool is_mutable_compound(const JPH::Body &body)
+    {
+        return body.GetShape()->GetSubType() ==
+               JPH::EShapeSubType::MutableCompound;
+    }
+
+    static float inverse_mass(const JPH::Body &body)
+    {
+        return body.IsDynamic() ? body.GetMotionProperties()->GetInverseMass()
+                                : 0.F;
+    }
+
+    // Jolt does not report solver impulses to the listener, so the impact is
+    // estimated as the impulse that would stop the pair closing along the
+    // contact normal
+    void record_impact(const JPH::Body &body1,
+                       const JPH::Body &body2,
+                       const JPH::ContactManifold &manifold)
+    {
+        const bool compound1{is_mutable_compound(body1)};
+        const bool compound2{is_mutable_compound(body2)};
+        if (!compound1 && !compound2)
+        {
+            return;
+        }
+        const JPH::RVec3 point{manifold.GetWorldSpaceContactPointOn1(0)};
+        const float closing_speed{
+            (body1.GetPointVelocity(point) - body2.GetPointVelocity(point))
+                .Dot(manifold.mWorldSpaceNormal)};
+        const float inverse_masses{inverse_mass(body1) + inverse_mass(body2)};
+        if (closing_speed <= 0.F || inverse_masses == 0.F)
+        {
+            return;
+        }
+        const float impulse{closing_speed / inverse_masses};
+        if (compound1)
+        {
+            push_impact(
+                CompoundImpact{body1.GetID(), manifold.mSubShapeID1, impulse});
+        }
+        if (compound2)
+        {
+            push_impact(
+                CompoundImpact{body2.GetID(), manifold.mSubShapeID2, impulse});
+        }
+    }
+
+    // Called from several physics jobs at once. Each impact claims its own
+    // slot, so no lock is needed.
+    void push_impact(const CompoundImpact &impact)
+    {
+        const std::size_t slot{
+            _impact_count.fetch_add(1, std::memory_order_relaxed)};
+        if (slot < _impacts.size())
+        {
+            _impacts[slot] = impact;
+        }
+    }
+
+    // Called from several physics jobs at once
+    void record_penetration(const float penetration)
+    {
+        float current{_max_penetration.load(std::memory_order_relaxed)};
+        while (penetration > current &&
+               !_max_penetration.compare_exchange_weak(
+                   current, penetration, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    std::atomic<float> _max_penetration{0.F};
+    std::vector<CompoundImpact> _impacts;
+    std::atomic<std::size_t> _impact_count{0};
+};
+
+// An example activation listener
+class MyBodyActivationListener : public JPH::BodyActivationListener
+{
+public:
+    void OnBodyActivated(const JPH::BodyID & /* inBodyID */,
+                         JPH::uint64 /* inBodyUserData */) override
+    {
+        SPDLOG_DEBUG("A body got activated");
+    }
+
+    void OnBodyDeactivated(const JPH::BodyID & /* &inBodyID */,
+                           JPH::uint64 /* inBodyUserData */) override
+    {
+        SPDLOG_DEBUG("A body went to sleep");
+    }
+};
+
+// Copy of the parts of a body's state that tools outside the engine need
+struct BodyState
+{
+    JPH::BodyID id;
+    JPH::ObjectLayer layer;
+    JPH::EMotionType motion_type;
+    JPH::RVec3 position;
+    JPH::Quat rotation;
+    JPH::Vec3 linear_velocity;
+    JPH::Vec3 angular_velocity;
+    bool active;
+};
+
+// Rolling per-step cost and quality numbers, for the dev panel graphs. Values
+// are written at next and wrap around.
+struct StepStatsHistory
+{
+    static constexpr std::size_t kLength{120};
+
+    std::array<float, kLength> step_milliseconds{};
+    std::array<float, kLength> max_penetration{};
+    std::array<float, kLength> energy_change{};
+    std::size_t next{0};
+};
+
+// Capacities passed to PhysicsEngine::initialise. The defaults suit the hello
+// world scene; larger worlds need room for more bodies, pairs and contacts.
+struct PhysicsConfig
+{
+    JPH::uint max_bodies{1'024};
+    JPH::uint max_body_pairs{1'024};
+    JPH::uint max_contact_constraints{1'024};
+    std::size_t temp_allocator_bytes{std::size_t{10} * 1'024 * 1'024};
+    // Job system worker threads, on top of the thread calling update. Negative
+    // means one fewer than the number of hardware threads.
+    int worker_threads{-1};
+};
+
+// A config with room for body_count bodies, plus headroom for the pairs,
+// contacts and temporary memory a world of that many bodies generates
+[[nodiscard]] PhysicsConfig physics_config_for(std::size_t body_count);
+
+class PhysicsEngine
+{
+public:
+    PhysicsEngine();
+
+    // mutator methods
+    void initialise(const PhysicsConfig &config = PhysicsConfig{});
+    void create_floor(const Vec3 &floor_dimensions,
+                      const Vec3 &floor_position);
+    void create_ball(float ball_radius,
+                     const Vec3 &ball_position,
+                     const Vec3 &ball_velocity);
+    // Adds a dynamic ball that is not tracked as the scene's ball. Returns an
+    // invalid ID when the world is full.
+    JPH::BodyID add_ball(float ball_radius,
+                         const Vec3 &ball_position,
+                         const Vec3 &ball_velocity);
+    // Creates the bodies and adds them to the world as one batch, so the broad
+    // phase takes them in a single insert rather than one per body. body_ids
+    // gets an ID per settings entry, invalid where the world was full.
+    void add_bodies(const std::vector<JPH::BodyCreationSettings> &settings,
+                    JPH::BodyIDVector &body_ids);
+    // Removes and destroys the bodies as one batch. Reorders body_ids.
+    void remove_bodies(JPH::BodyIDVector &body_ids);
+    // Makes an existing dynamic body the scene's ball
+    void set_ball(const JPH::BodyID &body_id);
+    void destroy_body(const JPH::BodyID &body_id);
+    // Gives a body a new shape, keeping the shape's origin where it was, and
+    // refits its broad phase bounds. Wakes the body if it is dynamic.
+    void set_shape(const JPH::BodyID &body_id,
+                   const JPH::Shape *shape,
+                   bool update_mass);
+    void add_ball_velocity(const Vec3 &velocity);
+    // Queues an explosion. A dynamic body whose centre of mass is within
+    // radius of centre is pushed away from it with an impulse of
+    // strength * (1 - distance / radius) ^ falloff N s. Every explosion queued
+    // before the next update or step is applied at its start in one pass: a
+    // single broad phase query over their combined bounds, one impulse per
+    // body and one activation call for the sleeping bodies that were hit.
+    void apply_radial_impulse(const Vec3 &centre,
+                              float radius,
+                              float strength,
+                              float falloff = 1.F);
+    void start_simulation();
+    // Steps the world while any body is awake. sphere_position gets the
+    // scene's ball position after the step, and is left alone when there is
+    // no ball.
+    bool update(float cDeltaTime, Vec3 &sphere_position);
+    // Steps the world unconditionally
+    void step(float delta_time);
+    void save_state(JPH::StateRecorder &recorder) const;
+    bool restore_state(JPH::StateRecorder &recorder);
+    void cleanup();
+
+    // Run non-physics work on the physics job system, so it shares worker
+    // threads with the simulation instead of spinning up threads of its own.
+    // Only call these between physics updates.
+    JPH::JobHandle create_job(const char *name,
+                              const JPH::JobSystem::JobFunction &job_function);
+    void wait_for_job(const JPH::JobHandle &job);
+
+    // accessor methods
+    // These read bodies without locking, so only call them between physics
+    // updates, from the main thread or a job it waits for before stepping
+    [[nodiscard]] const JPH::PhysicsSettings &get_physics_settings() const;
+    void set_physics_settings(const JPH::PhysicsSettings &physics_settings);
+    void set_gravity(const Vec3 &gravity);
+    [[nodiscard]] const StepStatsHistory &get_step_stats_history() const;
+    // Contacts that started on MutableCompoundShape bodies during the last
+    // step
+    [[nodiscard]] const std::vector<CompoundImpact> &get_compound_impacts()
+        const;
+    [[nodiscard]] JPH::uint get_step() const;
+    [[nodiscard]] JPH::uint get_num_bodies() const;
+    void get_body_ids(JPH::BodyIDVector &body_ids) const;
+    void get_active_body_ids(JPH::BodyIDVector &body_ids) const;
+    [[nodiscard]] bool get_body_state(const JPH::BodyID &body_id,
+                                      BodyState &body_state) const;
+    // Cheaper than get_body_state when only the position is needed
+    [[nodiscard]] bool get_body_position(const JPH::BodyID &body_id,
+                                         Vec3 &position) const;
+    // The user data of the part of a body a contact or query hit. For a
+    // compound that is the hit sub-shape's user data, otherwise the body's.
+    [[nodiscard]] bool get_sub_shape_user_data(
+        const JPH::BodyID &body_id,
+        const JPH::SubShapeID &sub_shape_id,
+        JPH::uint64 &user_data) const;
+    // Bodies in any layer whose bounds overlap the box, from the broad phase
+    // alone. Clears body_ids first.
+    void get_bodies_in_box(const Vec3 &min,
+                           const Vec3 &max,
+                           JPH::BodyIDVector &body_ids) const;
+
+private:
+    struct RadialImpulse
+    {
+        JPH::Vec3 centre;
+        float radius;
+        float strength;
+        float falloff;
+    };
+
+    void apply_radial_impulses();
+    void record_step_stats(float step_milliseconds);
+    [[nodiscard]] float compute_energy_change();
+    [[nodiscard]] float compute_body_energy(const JPH::BodyIDVector &body_ids,
+                                            bool &complete) const;
+
+    JPH::uint _step{0};
+    StepStatsHistory _step_stats{};
+    JPH::BodyIDVector _active_body_ids{};
+    // Sorted, the bodies _last_energy was summed over
+    JPH::BodyIDVector _energy_body_ids{};
+    JPH::BodyIDVector _batch_body_ids{};
+    std::vector<CompoundImpact> _compound_impacts{};
+    std::vector<RadialImpulse> _radial_impulses{};
+    JPH::BodyIDVector _impulse_body_ids{};
+    JPH::BodyIDVector _wake_body_ids{};
+    float _last_energy{0.F};
+    std::unique_ptr<JPH::PhysicsSystem> _physics_system;
+    std::unique_ptr<JPH::TempAllocatorImpl> _temp_allocator;
+    std::unique_ptr<JPH::JobSystemThreadPool> _job_system;
+    std::unique_ptr<MyBodyActivationListener> _body_activation_listener;
+    std::unique_ptr<MyContactListener> _contact_listener;
+    std::unique_ptr<BPLayerInterfaceImpl> _broad_phase_layer_interface;
+    std::unique_ptr<ObjectVsBroadPhaseLayerFilterImpl>
+        _object_vs_broadphase_layer_filter;
+    std::unique_ptr<ObjectLayerPairFilterImpl> _object_vs_object_layer_filter;
+    JPH::BodyID _sphere_id;
+    JPH::BodyID _floor_id;
+};
+
+#endif
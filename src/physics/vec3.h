@@ -0,0 +1,14 @@
+#ifndef SRC_PHYSICS_VEC3_H
+#define SRC_PHYSICS_VEC3_H
+
+// Plain three component vector for the physics library's interface, so the
+// library does not depend on raylib. It has the same layout as raylib's
+// Vector3; src/raylib_vec3.h converts between the two.
+struct Vec3
+{
+    float x;
+    float y;
+    float z;
+};
+
+#endif
@@ -0,0 +1,216 @@
+#include "cpu_features.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define JOLT_RAYLIB_X86_MSVC
+#include <immintrin.h>
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#define JOLT_RAYLIB_X86_GCC
+#include <cpuid.h>
+#endif
+
+namespace
+{
+constexpr std::array<IsaLevel, 4> kLevels{
+    IsaLevel::SSE2, IsaLevel::SSE4_2, IsaLevel::AVX2, IsaLevel::AVX512};
+
+struct CpuidRegisters
+{
+    uint32_t eax{0};
+    uint32_t ebx{0};
+    uint32_t ecx{0};
+    uint32_t edx{0};
+};
+
+bool bit(const uint32_t value, const unsigned int index)
+{
+    return ((value >> index) & 1U) != 0U;
+}
+
+#if defined(JOLT_RAYLIB_X86_MSVC)
+CpuidRegisters cpuid(const uint32_t leaf, const uint32_t subleaf)
+{
+    std::array<int, 4> registers{};
+    __cpuidex(registers.data(),
+              static_cast<int>(leaf),
+              static_cast<int>(subleaf));
+    return CpuidRegisters{static_cast<uint32_t>(registers[0]),
+                          static_cast<uint32_t>(registers[1]),
+                          static_cast<uint32_t>(registers[2]),
+                          static_cast<uint32_t>(registers[3])};
+}
+
+uint64_t xgetbv()
+{
+    return _xgetbv(0);
+}
+#elif defined(JOLT_RAYLIB_X86_GCC)
+CpuidRegisters cpuid(const uint32_t leaf, const uint32_t subleaf)
+{
+    CpuidRegisters registers{};
+    __cpuid_count(leaf,
+                  subleaf,
+                  registers.eax,
+                  registers.ebx,
+                  registers.ecx,
+                  registers.edx);
+    return registers;
+}
+
+// Inline assembly rather than _xgetbv, which needs the file compiled with
+// -mxsave
+uint64_t xgetbv()
+{
+    uint32_t low{0};
+    uint32_t high{0};
+    __asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return (static_cast<uint64_t>(high) << 32U) | low;
+}
+#endif
+} // namespace
+
+CpuFeatures read_cpu_features()
+{
+    CpuFeatures features{};
+#if defined(JOLT_RAYLIB_X86_MSVC) || defined(JOLT_RAYLIB_X86_GCC)
+    const uint32_t max_leaf{cpuid(0, 0).eax};
+    const uint32_t max_extended_leaf{cpuid(0x8000'0000U, 0).eax};
+    if (max_leaf < 1)
+    {
+        return features;
+    }
+
+    const CpuidRegisters leaf_1{cpuid(1, 0)};
+    features.sse4_1 = bit(leaf_1.ecx, 19);
+    features.sse4_2 = bit(leaf_1.ecx, 20);
+    features.popcnt = bit(leaf_1.ecx, 23);
+
+    // XCR0 says which register files the operating system saves on a context
+    // switch: SSE and AVX state, then the three AVX-512 state components
+    constexpr uint64_t kAvxState{0x6};
+    constexpr uint64_t kAvx512State{0xE6};
+    const bool os_saves_registers{bit(leaf_1.ecx, 27)};
+    const uint64_t enabled_state{os_saves_registers ? xgetbv() : 0};
+    const bool avx_enabled{(enabled_state & kAvxState) == kAvxState};
+    const bool avx512_enabled{(enabled_state & kAvx512State) == kAvx512State};
+
+    features.avx = avx_enabled && bit(leaf_1.ecx, 28);
+    features.fma = avx_enabled && bit(leaf_1.ecx, 12);
+    features.f16c = avx_enabled && bit(leaf_1.ecx, 29);
+
+    if (max_leaf >= 7)
+    {
+        const CpuidRegisters leaf_7{cpuid(7, 0)};
+        features.bmi1 = bit(leaf_7.ebx, 3);
+        features.avx2 = avx_enabled && bit(leaf_7.ebx, 5);
+        features.avx512f = avx512_enabled && bit(leaf_7.ebx, 16);
+        features.avx512dq = avx512_enabled && bit(leaf_7.ebx, 17);
+        features.avx512vl = avx512_enabled && bit(leaf_7.ebx, 31);
+    }
+    if (max_extended_leaf >= 0x8000'0001U)
+    {
+        features.lzcnt = bit(cpuid(0x8000'0001U, 0).ecx, 5);
+    }
+#endif
+    return features;
+}
+
+bool supports(const CpuFeatures &features, const IsaLevel level)
+{
+    // Mirrors the compiler flags Jolt adds for each set of USE_* options
+    const bool sse4_2{features.sse4_1 && features.sse4_2 && features.popcnt};
+    const bool avx2{sse4_2 && features.avx && features.avx2 && features.fma &&
+                    features.f16c && features.lzcnt && features.bmi1};
+    switch (level)
+    {
+    case IsaLevel::SSE2:
+        return true;
+    case IsaLevel::SSE4_2:
+        return sse4_2;
+    case IsaLevel::AVX2:
+        return avx2;
+    case IsaLevel::AVX512:
+        return avx2 && features.avx512f && features.avx512vl &&
+               features.avx512dq;
+    }
+    return false;
+}
+
+IsaLevel best_isa_level(const CpuFeatures &features)
+{
+    IsaLevel best{IsaLevel::SSE2};
+    for (const IsaLevel level : kLevels)
+    {
+        if (supports(features, level))
+        {
+            best = level;
+        }
+    }
+    return best;
+}
+
+std::string_view isa_name(const IsaLevel level)
+{
+    switch (level)
+    {
+    case IsaLevel::SSE2:
+        return "SSE2";
+    case IsaLevel::SSE4_2:
+        return "SSE4_2";
+    case IsaLevel::AVX2:
+        return "AVX2";
+    case IsaLevel::AVX512:
+        return "AVX512";
+    }
+    return "?";
+}
+
+std::string_view isa_suffix(const IsaLevel level)
+{
+    switch (level)
+    {
+    case IsaLevel::SSE2:
+        return "sse2";
+    case IsaLevel::SSE4_2:
+        return "sse4_2";
+    case IsaLevel::AVX2:
+        return "avx2";
+    case IsaLevel::AVX512:
+        return "avx512";
+    }
+    return "?";
+}
+
+std::optional<IsaLevel> parse_isa_level(const std::string_view name)
+{
+    const auto same_ignoring_case{
+        [](const std::string_view lhs, const std::string_view rhs)
+        {
+            return std::equal(lhs.begin(),
+                              lhs.end(),
+                              rhs.begin(),
+                              rhs.end(),
+                              [](const char lhs_char, const char rhs_char)
+                              {
+                                  return std::toupper(static_cast<unsigned char>(
+                                             lhs_char)) ==
+                                         std::toupper(static_cast<unsigned char>(
+                                             rhs_char));
+                              });
+        }};
+    for (const IsaLevel level : kLevels)
+    {
+        if (same_ignoring_case(name, isa_name(level)))
+        {
+            return level;
+        }
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,51 @@
+#ifndef SRC_PLATFORM_CPU_FEATURES_H
+#define SRC_PLATFORM_CPU_FEATURES_H
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+// x86 instruction set levels the physics can be built for. Each matches a
+// JOLT_RAYLIB_ISA value, and so a set of Jolt USE_* options.
+enum class IsaLevel : uint8_t
+{
+    SSE2,
+    SSE4_2,
+    AVX2,
+    AVX512
+};
+
+// The CPUID features the Jolt USE_* options depend on. The AVX flags are only
+// set when the operating system also saves the wider registers.
+struct CpuFeatures
+{
+    bool sse4_1{false};
+    bool sse4_2{false};
+    bool popcnt{false};
+    bool avx{false};
+    bool avx2{false};
+    bool fma{false};
+    bool f16c{false};
+    bool lzcnt{false};
+    bool bmi1{false}; // includes tzcnt
+    bool avx512f{false};
+    bool avx512vl{false};
+    bool avx512dq{false};
+};
+
+// Reads the features of the CPU this process is running on. Every feature is
+// false on processors other than x86.
+CpuFeatures read_cpu_features();
+
+// Whether a build for the level can run with these features
+bool supports(const CpuFeatures &features, IsaLevel level);
+// The highest level these features can run
+IsaLevel best_isa_level(const CpuFeatures &features);
+
+// JOLT_RAYLIB_ISA spelling, such as "AVX2"
+std::string_view isa_name(IsaLevel level);
+// Lower case form used in variant executable names, such as "avx2"
+std::string_view isa_suffix(IsaLevel level);
+std::optional<IsaLevel> parse_isa_level(std::string_view name);
+
+#endif
@@ -0,0 +1,147 @@
+#include "file_watcher.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+std::filesystem::file_time_type write_time(const std::filesystem::path &path)
+{
+    // A missing file reads as the minimum time, so creating it counts as a
+    // change
+    std::error_code error{};
+    const std::filesystem::file_time_type time{
+        std::filesystem::last_write_time(path, error)};
+    return error ? std::filesystem::file_time_type::min() : time;
+}
+} // namespace
+
+FileWatcher::FileWatcher()
+{
+#ifdef __linux__
+    _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_inotify < 0)
+    {
+        spdlog::warn("inotify unavailable ({}), polling file times instead",
+                     std::strerror(errno));
+    }
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+    if (_inotify >= 0)
+    {
+        ::close(_inotify);
+    }
+#endif
+}
+
+std::size_t FileWatcher::watch(const std::filesystem::path &path)
+{
+    Watch watch{};
+    watch.path = path;
+    watch.file_name = path.filename();
+    watch.write_time = write_time(path);
+#ifdef __linux__
+    if (_inotify >= 0)
+    {
+        // Watching the directory rather than the file survives the file being
+        // replaced. Watching the same directory twice returns the same
+        // descriptor.
+        const std::filesystem::path directory{
+            path.has_parent_path() ? path.parent_path()
+                                   : std::filesystem::path{"."}};
+        watch.descriptor = inotify_add_watch(_inotify,
+                                             directory.c_str(),
+                                             IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (watch.descriptor < 0)
+        {
+            spdlog::warn("Unable to watch {} ({}), polling its time instead",
+                         directory.string(),
+                         std::strerror(errno));
+        }
+    }
+#endif
+    _watches.push_back(watch);
+    return _watches.size() - 1;
+}
+
+void FileWatcher::poll()
+{
+#ifdef __linux__
+    if (_inotify >= 0)
+    {
+        for (;;)
+        {
+            const ssize_t length{
+                ::read(_inotify, _events.data(), _events.size())};
+            if (length <= 0)
+            {
+                break;
+            }
+            for (std::size_t offset{0};
+                 offset < static_cast<std::size_t>(length);)
+            {
+                inotify_event event{};
+                std::memcpy(&event, _events.data() + offset, sizeof(event));
+                const char *name{_events.data() + offset + sizeof(event)};
+                for (Watch &watch : _watches)
+                {
+                    if (watch.descriptor == event.wd && event.len > 0 &&
+                        watch.file_name == name)
+                    {
+                        watch.changed = true;
+                    }
+                }
+                offset += sizeof(event) + event.len;
+            }
+        }
+    }
+#endif
+    poll_write_times();
+}
+
+bool FileWatcher::take_changed(const std::size_t handle)
+{
+    Watch &watch{_watches.at(handle)};
+    const bool changed{watch.changed};
+    watch.changed = false;
+    return changed;
+}
+
+void FileWatcher::poll_write_times()
+{
+    const auto now{std::chrono::steady_clock::now()};
+    if (now < _next_poll)
+    {
+        return;
+    }
+    _next_poll = now + kPollInterval;
+
+    for (Watch &watch : _watches)
+    {
+        if (watch.descriptor >= 0)
+        {
+            continue;
+        }
+        const std::filesystem::file_time_type time{write_time(watch.path)};
+        if (time != watch.write_time)
+        {
+            watch.write_time = time;
+            watch.changed = true;
+        }
+    }
+}
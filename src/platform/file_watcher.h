@@ -0,0 +1,53 @@
+#ifndef SRC_PLATFORM_FILE_WATCHER_H
+#define SRC_PLATFORM_FILE_WATCHER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+// Reports files that have been written since the last poll. On Linux it uses
+// inotify on each file's directory, so editors that save by renaming a new
+// file into place are seen too, and a poll with nothing to report is a single
+// non-blocking read. Elsewhere, or when inotify is unavailable, it compares
+// modification times at most every kPollInterval.
+class FileWatcher
+{
+public:
+    static constexpr std::chrono::milliseconds kPollInterval{500};
+
+    FileWatcher();
+    FileWatcher(const FileWatcher &) = delete;
+    FileWatcher &operator=(const FileWatcher &) = delete;
+    FileWatcher(FileWatcher &&) = delete;
+    FileWatcher &operator=(FileWatcher &&) = delete;
+    ~FileWatcher();
+
+    // The file need not exist yet. Returns the handle take_changed takes.
+    std::size_t watch(const std::filesystem::path &path);
+    // Non-blocking. Call once a frame.
+    void poll();
+    // Whether the file changed since the last call, clearing the flag
+    bool take_changed(std::size_t handle);
+
+private:
+    struct Watch
+    {
+        std::filesystem::path path{};
+        std::filesystem::path file_name{};
+        std::filesystem::file_time_type write_time{};
+        int descriptor{-1};
+        bool changed{false};
+    };
+
+    void poll_write_times();
+
+    std::vector<Watch> _watches{};
+    std::chrono::steady_clock::time_point _next_poll{};
+    // The inotify instance, -1 when falling back to modification times
+    int _inotify{-1};
+    alignas(8) std::array<char, 4'096> _events{};
+};
+
+#endif
@@ -0,0 +1,229 @@
+#include "mapped_file.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <system_error>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::create(const std::filesystem::path &path,
+                        const std::size_t size)
+{
+    return map(path, size, true);
+}
+
+bool MappedFile::open_read_only(const std::filesystem::path &path)
+{
+    std::error_code error{};
+    const std::uintmax_t size{std::filesystem::file_size(path, error)};
+    if (error)
+    {
+        spdlog::error("Unable to read size of {}: {}",
+                      path.string(),
+                      error.message());
+        return false;
+    }
+    return map(path, static_cast<std::size_t>(size), false);
+}
+
+bool MappedFile::is_open() const
+{
+    return _data != nullptr;
+}
+
+std::byte *MappedFile::data()
+{
+    return _data;
+}
+
+const std::byte *MappedFile::data() const
+{
+    return _data;
+}
+
+std::size_t MappedFile::size() const
+{
+    return _size;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::map(const std::filesystem::path &path,
+                     const std::size_t size,
+                     const bool writable)
+{
+    close();
+
+    const DWORD access{writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ};
+    const DWORD disposition{writable ? OPEN_ALWAYS : OPEN_EXISTING};
+    HANDLE file{CreateFileW(path.c_str(),
+                            access,
+                            FILE_SHARE_READ,
+                            nullptr,
+                            disposition,
+                            FILE_ATTRIBUTE_NORMAL,
+                            nullptr)};
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        spdlog::error("Unable to open {}: error {}",
+                      path.string(),
+                      GetLastError());
+        return false;
+    }
+
+    // Creating a writable mapping larger than the file grows the file
+    const auto size_64{static_cast<unsigned long long>(size)};
+    HANDLE mapping{
+        CreateFileMappingW(file,
+                           nullptr,
+                           writable ? PAGE_READWRITE : PAGE_READONLY,
+                           static_cast<DWORD>(size_64 >> 32U),
+                           static_cast<DWORD>(size_64 & 0xFFFF'FFFFU),
+                           nullptr)};
+    if (mapping == nullptr)
+    {
+        spdlog::error("Unable to map {}: error {}",
+                      path.string(),
+                      GetLastError());
+        CloseHandle(file);
+        return false;
+    }
+
+    void *view{MapViewOfFile(
+        mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size)};
+    if (view == nullptr)
+    {
+        spdlog::error("Unable to map a view of {}: error {}",
+                      path.string(),
+                      GetLastError());
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    _file = file;
+    _mapping = mapping;
+    _data = static_cast<std::byte *>(view);
+    _size = size;
+    return true;
+}
+
+void MappedFile::flush()
+{
+    if (_data != nullptr)
+    {
+        FlushViewOfFile(_data, 0);
+    }
+}
+
+void MappedFile::close()
+{
+    if (_data != nullptr)
+    {
+        UnmapViewOfFile(_data);
+        _data = nullptr;
+    }
+    if (_mapping != nullptr)
+    {
+        CloseHandle(_mapping);
+        _mapping = nullptr;
+    }
+    if (_file != nullptr)
+    {
+        CloseHandle(_file);
+        _file = nullptr;
+    }
+    _size = 0;
+}
+
+#else
+
+bool MappedFile::map(const std::filesystem::path &path,
+                     const std::size_t size,
+                     const bool writable)
+{
+    close();
+
+    const int descriptor{
+        writable ? ::open(path.c_str(), O_RDWR | O_CREAT, 0644) // NOLINT
+                 : ::open(path.c_str(), O_RDONLY)}; // NOLINT
+    if (descriptor < 0)
+    {
+        spdlog::error("Unable to open {}: {}",
+                      path.string(),
+                      std::system_category().message(errno));
+        return false;
+    }
+
+    if (writable && ::ftruncate(descriptor, static_cast<off_t>(size)) != 0)
+    {
+        spdlog::error("Unable to resize {}: {}",
+                      path.string(),
+                      std::system_category().message(errno));
+        ::close(descriptor);
+        return false;
+    }
+
+    void *mapping{::mmap(nullptr,
+                         size,
+                         writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                         MAP_SHARED,
+                         descriptor,
+                         0)};
+    if (mapping == MAP_FAILED) // NOLINT [cppcoreguidelines-pro-type-cstyle-cast]
+    {
+        spdlog::error("Unable to map {}: {}",
+                      path.string(),
+                      std::system_category().message(errno));
+        ::close(descriptor);
+        return false;
+    }
+
+    _descriptor = descriptor;
+    _data = static_cast<std::byte *>(mapping);
+    _size = size;
+    return true;
+}
+
+void MappedFile::flush()
+{
+    if (_data != nullptr)
+    {
+        ::msync(_data, _size, MS_ASYNC);
+    }
+}
+
+void MappedFile::close()
+{
+    if (_data != nullptr)
+    {
+        ::munmap(_data, _size);
+        _data = nullptr;
+    }
+    if (_descriptor >= 0)
+    {
+        ::close(_descriptor);
+        _descriptor = -1;
+    }
+    _size = 0;
+}
+
+#endif
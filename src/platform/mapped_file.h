@@ -0,0 +1,49 @@
+#ifndef SRC_PLATFORM_MAPPED_FILE_H
+#define SRC_PLATFORM_MAPPED_FILE_H
+
+#include <cstddef>
+#include <filesystem>
+
+// A file mapped into memory with mmap on POSIX systems and a file mapping on
+// Windows. Writes go to the page cache shared with the file, so the operating
+// system still writes them back if the process crashes before close().
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&) = delete;
+    MappedFile &operator=(MappedFile &&) = delete;
+    ~MappedFile();
+
+    // Creates the file, or resizes an existing one, and maps it read-write.
+    // Failures are logged and leave the file closed.
+    bool create(const std::filesystem::path &path, std::size_t size);
+    // Maps an existing file read-only
+    bool open_read_only(const std::filesystem::path &path);
+    // Starts writing dirty pages back without waiting for them
+    void flush();
+    void close();
+
+    [[nodiscard]] bool is_open() const;
+    [[nodiscard]] std::byte *data();
+    [[nodiscard]] const std::byte *data() const;
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    bool map(const std::filesystem::path &path,
+             std::size_t size,
+             bool writable);
+
+    std::byte *_data{nullptr};
+    std::size_t _size{0};
+#ifdef _WIN32
+    void *_file{nullptr};
+    void *_mapping{nullptr};
+#else
+    int _descriptor{-1};
+#endif
+};
+
+#endif
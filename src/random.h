@@ -0,0 +1,16 @@
+#ifndef SRC_RANDOM_H
+#define SRC_RANDOM_H
+
+#include <random>
+
+// std::uniform_real_distribution gives different sequences on different
+// standard libraries, but mt19937's raw output is specified exactly. Map it to
+// [-1, 1) by hand so a seed gives the same values everywhere.
+inline float next_signed_unit(std::mt19937 &generator)
+{
+    constexpr double kRange{4'294'967'296.0};
+    return static_cast<float>(static_cast<double>(generator()) / kRange * 2.0 -
+                              1.0);
+}
+
+#endif
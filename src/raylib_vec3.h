@@ -0,0 +1,19 @@
+#ifndef SRC_RAYLIB_VEC3_H
+#define SRC_RAYLIB_VEC3_H
+
+#include "physics/vec3.h"
+
+#include <raylib.h>
+
+// Conversions between raylib's Vector3 and the physics library's Vec3
+inline Vector3 to_vector3(const Vec3 &vec3)
+{
+    return Vector3{vec3.x, vec3.y, vec3.z};
+}
+
+inline Vec3 to_vec3(const Vector3 &vector3)
+{
+    return Vec3{vector3.x, vector3.y, vector3.z};
+}
+
+#endif
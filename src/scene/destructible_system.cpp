@@ -0,0 +1,423 @@
+#include "destructible_system.h"
+
+#include "physics/physics.h"
+#include "physics/vec3.h"
+#include "scene.h"
+#include "scene_loader.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Core/Reference.h>
+#include <Jolt/Math/Quat.h>
+#include <Jolt/Math/Real.h>
+#include <Jolt/Math/Vec3.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Body/MotionType.h>
+#include <Jolt/Physics/Collision/Shape/CompoundShape.h>
+#include <Jolt/Physics/Collision/Shape/MutableCompoundShape.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+#include <Jolt/Physics/Collision/Shape/SubShapeID.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+// Offset of part index along an axis of count parts, centred on zero
+float part_offset(const uint32_t index,
+                  const uint32_t count,
+                  const float spacing)
+{
+    return (static_cast<float>(index) -
+            static_cast<float>(count - 1) * 0.5F) *
+           spacing;
+}
+
+std::size_t part_count(const SceneDestructible &destructible)
+{
+    return std::size_t{destructible.parts_x} * destructible.parts_y *
+           destructible.parts_z;
+}
+
+JPH::RVec3 centre_of_mass(const BodyState &state,
+                          const JPH::MutableCompoundShape &shape)
+{
+    return state.position + state.rotation * shape.GetCenterOfMass();
+}
+} // namespace
+
+DestructibleSystem::DestructibleSystem(PhysicsEngine &physics_engine)
+    : _physics_engine{physics_engine}
+{
+}
+
+void DestructibleSystem::set_destructibles(
+    const std::vector<SceneDestructible> &destructibles)
+{
+    clear();
+    _destructibles = destructibles;
+    _part_shapes.clear();
+    _settings.clear();
+    _settings_shapes.clear();
+    _settings_sources.clear();
+    for (std::size_t index{0}; index < _destructibles.size(); ++index)
+    {
+        const SceneDestructible &destructible{_destructibles[index]};
+        const JPH::ShapeRefC part_shape{
+            new JPH::SphereShape{destructible.part_radius}};
+        _part_shapes.push_back(part_shape);
+
+        // Each part's user data is its place in the block, which stays the
+        // same as other parts are removed around it
+        JPH::MutableCompoundShapeSettings compound{};
+        const float spacing{destructible.part_radius * 2.F};
+        uint32_t part{0};
+        for (uint32_t z{0}; z < destructible.parts_z; ++z)
+        {
+            for (uint32_t y{0}; y < destructible.parts_y; ++y)
+            {
+                for (uint32_t x{0}; x < destructible.parts_x; ++x)
+                {
+                    compound.AddShape(
+                        JPH::Vec3{
+                            part_offset(x, destructible.parts_x, spacing),
+                            part_offset(y, destructible.parts_y, spacing),
+                            part_offset(z, destructible.parts_z, spacing)},
+                        JPH::Quat::sIdentity(),
+                        part_shape.GetPtr(),
+                        part++);
+                }
+            }
+        }
+        // Built directly rather than through Create, which only hands back a
+        // const shape, and parts are removed from this one later
+        JPH::ShapeSettings::ShapeResult result{};
+        const JPH::Ref<JPH::MutableCompoundShape> shape{
+            new JPH::MutableCompoundShape{compound, result}};
+        if (result.HasError())
+        {
+            spdlog::error("Unable to build destructible {}: {}",
+                          index,
+                          result.GetError());
+            continue;
+        }
+
+        const bool is_static{destructible.motion == SceneMotion::Static};
+        JPH::BodyCreationSettings &settings{_settings.emplace_back(
+            shape.GetPtr(),
+            JPH::RVec3{destructible.position.x,
+                       destructible.position.y,
+                       destructible.position.z},
+            JPH::Quat::sIdentity(),
+            is_static ? JPH::EMotionType::Static : JPH::EMotionType::Dynamic,
+            is_static ? Layers::NON_MOVING : Layers::MOVING)};
+        settings.mFriction = destructible.material.friction;
+        settings.mRestitution = destructible.material.restitution;
+        _settings_shapes.push_back(shape);
+        _settings_sources.push_back(index);
+    }
+
+    if (!_settings.empty())
+    {
+        _physics_engine.add_bodies(_settings, _body_ids);
+    }
+    for (std::size_t index{0}; index < _settings.size(); ++index)
+    {
+        if (!_body_ids[index].IsInvalid())
+        {
+            _objects.push_back(Object{_body_ids[index],
+                                      _settings_shapes[index],
+                                      _settings_sources[index]});
+        }
+    }
+    _settings_shapes.clear();
+    std::sort(_objects.begin(),
+              _objects.end(),
+              [](const Object &lhs, const Object &rhs)
+              { return lhs.body_id < rhs.body_id; });
+
+    // Every part can break off in the same update, and a step reports at most
+    // kMaxCompoundImpacts impacts, so updates never grow these
+    const std::size_t parts{capacity()};
+    _spheres.reserve(parts);
+    _debris.reserve(parts);
+    _settings.reserve(parts);
+    _settings_radius.reserve(parts);
+    _body_ids.reserve(parts);
+    _remove_ids.reserve(_objects.size());
+    _breaks.reserve(MyContactListener::kMaxCompoundImpacts);
+    refresh_spheres();
+}
+
+void DestructibleSystem::update()
+{
+    const auto start{std::chrono::steady_clock::now()};
+    find_breaks();
+    apply_breaks();
+    refresh_spheres();
+    _stats.update_milliseconds = std::chrono::duration<float, std::milli>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count();
+}
+
+void DestructibleSystem::clear()
+{
+    _remove_ids.clear();
+    for (const Object &object : _objects)
+    {
+        if (object.shape != nullptr)
+        {
+            _remove_ids.push_back(object.body_id);
+        }
+    }
+    for (const SceneSphere &debris : _debris)
+    {
+        _remove_ids.push_back(debris.id);
+    }
+    _physics_engine.remove_bodies(_remove_ids);
+    _objects.clear();
+    _debris.clear();
+    _spheres.clear();
+}
+
+const std::vector<DestructibleSphere> &DestructibleSystem::spheres() const
+{
+    return _spheres;
+}
+
+std::size_t DestructibleSystem::capacity() const
+{
+    std::size_t total{0};
+    for (const SceneDestructible &destructible : _destructibles)
+    {
+        total += part_count(destructible);
+    }
+    return total;
+}
+
+const DestructibleStats &DestructibleSystem::stats() const
+{
+    return _stats;
+}
+
+void DestructibleSystem::find_breaks()
+{
+    // Sub-shape IDs are only valid for the shape they were made from, so every
+    // impact is turned into a part index before any shape changes
+    _breaks.clear();
+    for (const CompoundImpact &impact : _physics_engine.get_compound_impacts())
+    {
+        const auto found{std::lower_bound(
+            _objects.begin(),
+            _objects.end(),
+            impact.body_id,
+            [](const Object &object, const JPH::BodyID &body_id)
+            { return object.body_id < body_id; })};
+        if (found == _objects.end() || found->body_id != impact.body_id ||
+            found->shape == nullptr ||
+            impact.impulse < _destructibles[found->destructible].threshold)
+        {
+            continue;
+        }
+        JPH::SubShapeID remainder{};
+        const JPH::uint sub_shape{found->shape->GetSubShapeIndexFromID(
+            impact.sub_shape_id, remainder)};
+        _breaks.push_back(Break{
+            static_cast<std::size_t>(found - _objects.begin()), sub_shape});
+    }
+
+    // Grouped by object, parts in order, and a part hit twice breaks once
+    std::sort(_breaks.begin(),
+              _breaks.end(),
+              [](const Break &lhs, const Break &rhs)
+              {
+                  if (lhs.object != rhs.object)
+                  {
+                      return lhs.object < rhs.object;
+                  }
+                  return lhs.sub_shape < rhs.sub_shape;
+              });
+    _breaks.erase(std::unique(_breaks.begin(),
+                              _breaks.end(),
+                              [](const Break &lhs, const Break &rhs)
+                              {
+                                  return lhs.object == rhs.object &&
+                                         lhs.sub_shape == rhs.sub_shape;
+                              }),
+                  _breaks.end());
+}
+
+void DestructibleSystem::apply_breaks()
+{
+    _settings.clear();
+    _settings_radius.clear();
+    _remove_ids.clear();
+    _stats.parts_broken_last_update = static_cast<uint32_t>(_breaks.size());
+    _stats.objects_changed_last_update = 0;
+
+    for (std::size_t first{0}; first < _breaks.size();)
+    {
+        std::size_t last{first + 1};
+        while (last < _breaks.size() &&
+               _breaks[last].object == _breaks[first].object)
+        {
+            ++last;
+        }
+        Object &object{_objects[_breaks[first].object]};
+        const SceneDestructible &destructible{
+            _destructibles[object.destructible]};
+        if (destructible.detach)
+        {
+            detach_parts(object, first, last);
+        }
+
+        if (last - first == object.shape->GetNumSubShapes())
+        {
+            // A compound cannot be empty, so the last parts take the body
+            // with them
+            _remove_ids.push_back(object.body_id);
+            object.shape = nullptr;
+        }
+        else
+        {
+            rebuild_shape(object, first, last);
+        }
+        ++_stats.objects_changed_last_update;
+        first = last;
+    }
+
+    _physics_engine.remove_bodies(_remove_ids);
+    if (!_settings.empty())
+    {
+        _physics_engine.add_bodies(_settings, _body_ids);
+        for (std::size_t index{0}; index < _body_ids.size(); ++index)
+        {
+            if (!_body_ids[index].IsInvalid())
+            {
+                _debris.push_back(
+                    SceneSphere{_body_ids[index], _settings_radius[index]});
+            }
+        }
+    }
+    _stats.parts_broken_total += _breaks.size();
+}
+
+void DestructibleSystem::detach_parts(const Object &object,
+                                      const std::size_t first_break,
+                                      const std::size_t last_break)
+{
+    BodyState state{};
+    if (!_physics_engine.get_body_state(object.body_id, state))
+    {
+        return;
+    }
+
+    // Each part leaves where it was, moving as that point of the object was
+    const SceneDestructible &destructible{_destructibles[object.destructible]};
+    const JPH::RVec3 object_centre{centre_of_mass(state, *object.shape)};
+    for (std::size_t index{first_break}; index < last_break; ++index)
+    {
+        const JPH::CompoundShape::SubShape &part{
+            object.shape->GetSubShape(_breaks[index].sub_shape)};
+        const JPH::Vec3 offset{state.rotation * part.GetPositionCOM()};
+        JPH::BodyCreationSettings &settings{_settings.emplace_back(
+            _part_shapes[object.destructible],
+            object_centre + offset,
+            state.rotation * part.GetRotation(),
+            JPH::EMotionType::Dynamic,
+            Layers::MOVING)};
+        settings.mLinearVelocity =
+            state.linear_velocity + state.angular_velocity.Cross(offset);
+        settings.mAngularVelocity = state.angular_velocity;
+        settings.mFriction = destructible.material.friction;
+        settings.mRestitution = destructible.material.restitution;
+        _settings_radius.push_back(destructible.part_radius);
+    }
+}
+
+void DestructibleSystem::rebuild_shape(Object &object,
+                                       const std::size_t first_break,
+                                       const std::size_t last_break)
+{
+    // The breaks are in part order, so the broken parts are skipped in one
+    // pass over the shape
+    const JPH::MutableCompoundShape &shape{*object.shape};
+    const JPH::Vec3 shape_centre{shape.GetCenterOfMass()};
+    _rebuild_settings.mSubShapes.clear();
+    std::size_t next_break{first_break};
+    for (JPH::uint index{0}; index < shape.GetNumSubShapes(); ++index)
+    {
+        if (next_break < last_break && _breaks[next_break].sub_shape == index)
+        {
+            ++next_break;
+            continue;
+        }
+        // Parts are stored relative to the centre of mass, and the settings
+        // take them relative to the shape's origin
+        const JPH::CompoundShape::SubShape &part{shape.GetSubShape(index)};
+        _rebuild_settings.AddShape(part.GetPositionCOM() + shape_centre,
+                                   part.GetRotation(),
+                                   part.mShape.GetPtr(),
+                                   part.mUserData);
+    }
+
+    JPH::ShapeSettings::ShapeResult result{};
+    const JPH::Ref<JPH::MutableCompoundShape> rebuilt{
+        new JPH::MutableCompoundShape{_rebuild_settings, result}};
+    if (result.HasError())
+    {
+        spdlog::error("Unable to rebuild destructible {}: {}",
+                      object.destructible,
+                      result.GetError());
+        return;
+    }
+    _physics_engine.set_shape(
+        object.body_id,
+        rebuilt.GetPtr(),
+        _destructibles[object.destructible].motion == SceneMotion::Dynamic);
+    object.shape = rebuilt;
+}
+
+void DestructibleSystem::refresh_spheres()
+{
+    _spheres.clear();
+    for (const Object &object : _objects)
+    {
+        BodyState state{};
+        if (object.shape == nullptr ||
+            !_physics_engine.get_body_state(object.body_id, state))
+        {
+            continue;
+        }
+        const JPH::RVec3 object_centre{centre_of_mass(state, *object.shape)};
+        const float radius{_destructibles[object.destructible].part_radius};
+        for (JPH::uint index{0}; index < object.shape->GetNumSubShapes();
+             ++index)
+        {
+            const JPH::RVec3 position{
+                object_centre +
+                state.rotation *
+                    object.shape->GetSubShape(index).GetPositionCOM()};
+            _spheres.push_back(
+                DestructibleSphere{Vec3{static_cast<float>(position.GetX()),
+                                        static_cast<float>(position.GetY()),
+                                        static_cast<float>(position.GetZ())},
+                                   radius});
+        }
+    }
+    for (const SceneSphere &debris : _debris)
+    {
+        Vec3 position{0.F, 0.F, 0.F};
+        if (_physics_engine.get_body_position(debris.id, position))
+        {
+            _spheres.push_back(DestructibleSphere{position, debris.radius});
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef SRC_SCENE_DESTRUCTIBLE_SYSTEM_H
+#define SRC_SCENE_DESTRUCTIBLE_SYSTEM_H
+
+#include "physics/physics.h"
+#include "physics/vec3.h"
+#include "scene.h"
+#include "scene_loader.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Core/Reference.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Collision/Shape/MutableCompoundShape.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A part, attached or broken off, where it is now
+struct DestructibleSphere
+{
+    Vec3 position;
+    float radius;
+};
+
+struct DestructibleStats
+{
+    uint64_t parts_broken_total{0};
+    uint32_t parts_broken_last_update{0};
+    // Each of these had its shape refitted once, however many parts it lost
+    uint32_t objects_changed_last_update{0};
+    float update_milliseconds{0.F};
+};
+
+// Builds a scene's destructibles as MutableCompoundShape bodies with a sphere
+// sub-shape per part, and breaks parts off them. The physics step only
+// records impacts. update, called after the step, applies all of that step's
+// breaks object by object. Jolt's RemoveShape recomputes the compound's bounds
+// on every call, so rather than removing parts one at a time, the parts left
+// are built into a new shape once and swapped in, which computes the bounds,
+// centre of mass and broad phase bounds once per object however many parts
+// broke. Detached parts are created in one batched add and objects with no
+// parts left go in one batched remove.
+class DestructibleSystem
+{
+public:
+    explicit DestructibleSystem(PhysicsEngine &physics_engine);
+
+    // Replaces the current destructibles, and any debris, with new ones
+    void set_destructibles(const std::vector<SceneDestructible> &destructibles);
+    // Only call after a physics step, once per step
+    void update();
+    // Removes every destructible and piece of debris, for shutdown
+    void clear();
+
+    // Attached parts then debris, for rendering. Refreshed by update.
+    [[nodiscard]] const std::vector<DestructibleSphere> &spheres() const;
+    // Most spheres the destructibles can make
+    [[nodiscard]] std::size_t capacity() const;
+    [[nodiscard]] const DestructibleStats &stats() const;
+
+private:
+    struct Object
+    {
+        JPH::BodyID body_id;
+        // Null once every part has broken off
+        JPH::Ref<JPH::MutableCompoundShape> shape;
+        std::size_t destructible;
+    };
+
+    struct Break
+    {
+        std::size_t object;
+        JPH::uint sub_shape;
+    };
+
+    void find_breaks();
+    void apply_breaks();
+    void detach_parts(const Object &object,
+                      std::size_t first_break,
+                      std::size_t last_break);
+    void rebuild_shape(Object &object,
+                       std::size_t first_break,
+                       std::size_t last_break);
+    void refresh_spheres();
+
+    PhysicsEngine &_physics_engine;
+    std::vector<SceneDestructible> _destructibles{};
+    std::vector<JPH::ShapeRefC> _part_shapes{};
+    // Sorted by body ID, so impacts can be matched with a binary search
+    std::vector<Object> _objects{};
+    std::vector<SceneSphere> _debris{};
+    std::vector<DestructibleSphere> _spheres{};
+    // Scratch space reused every update
+    std::vector<Break> _breaks{};
+    std::vector<JPH::BodyCreationSettings> _settings{};
+    std::vector<float> _settings_radius{};
+    std::vector<JPH::Ref<JPH::MutableCompoundShape>> _settings_shapes{};
+    JPH::MutableCompoundShapeSettings _rebuild_settings{};
+    std::vector<std::size_t> _settings_sources{};
+    JPH::BodyIDVector _body_ids{};
+    JPH::BodyIDVector _remove_ids{};
+    DestructibleStats _stats{};
+};
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef SRC_SCENE_SCENE_H
+#define SRC_SCENE_SCENE_H
+
+#include "physics/vec3.h"
+
+#include <cstdint>
+#include <vector>
+
+// Plain descriptions of what a scene file contains. They do not depend on
+// Jolt, so the parser can be used and tested without a physics world.
+
+enum class SceneShape : uint8_t
+{
+    Box,
+    Sphere
+};
+
+enum class SceneMotion : uint8_t
+{
+    Static,
+    Dynamic
+};
+
+// Defaults match Jolt's BodyCreationSettings
+struct SceneMaterial
+{
+    float friction{0.2F};
+    float restitution{0.F};
+};
+
+// World capacities. Zero pair and contact limits are sized from max_bodies.
+struct SceneWorld
+{
+    uint32_t max_bodies{1'024};
+    uint32_t max_body_pairs{0};
+    uint32_t max_contact_constraints{0};
+    // Static boxes whose centres share a grid cell this size are merged into
+    // one body. Zero keeps every box a body of its own.
+    float merge_cell{0.F};
+};
+
+struct SceneBody
+{
+    SceneShape shape{SceneShape::Sphere};
+    SceneMotion motion{SceneMotion::Dynamic};
+    Vec3 position{0.F, 0.F, 0.F};
+    Vec3 half_extents{0.5F, 0.5F, 0.5F}; // boxes
+    float radius{0.5F};                  // spheres
+    Vec3 velocity{0.F, 0.F, 0.F};
+    SceneMaterial material{};
+    // The ball the player kicks and the camera reports on
+    bool ball{false};
+};
+
+// Emits dynamic spheres at a fixed rate. Each sphere starts somewhere in the
+// box of half extents area around position, with each velocity component
+// offset by up to the matching spread, and is despawned when it falls below
+// kill_y or has lived for lifetime seconds.
+struct SceneSpawner
+{
+    Vec3 position{0.F, 0.F, 0.F};
+    Vec3 area{0.F, 0.F, 0.F};
+    Vec3 velocity{0.F, 0.F, 0.F};
+    Vec3 velocity_spread{0.F, 0.F, 0.F};
+    float radius{0.5F};
+    float rate{1.F};     // spheres per second
+    uint32_t limit{100}; // most spheres alive at once
+    float lifetime{0.F}; // seconds, 0 lives until it leaves the world
+    float kill_y{-20.F};
+    SceneMaterial material{};
+};
+
+// A block of sphere parts, parts_x by parts_y by parts_z, packed side by side
+// around position and held together as one body. A part breaks off when a
+// new contact on it hits harder than threshold. It is removed, or with detach
+// carries on as a dynamic ball of its own.
+struct SceneDestructible
+{
+    SceneMotion motion{SceneMotion::Static};
+    Vec3 position{0.F, 0.F, 0.F};
+    uint32_t parts_x{1};
+    uint32_t parts_y{1};
+    uint32_t parts_z{1};
+    float part_radius{0.25F};
+    float threshold{10.F}; // N s
+    bool detach{false};
+    SceneMaterial material{};
+};
+
+// Receives a scene as it is parsed. begin is called once before anything
+// else, then bodies arrive in batches in file order, and end is called once
+// the whole file has been read.
+class SceneSink
+{
+public:
+    SceneSink() = default;
+    SceneSink(const SceneSink &) = delete;
+    SceneSink &operator=(const SceneSink &) = delete;
+    SceneSink(SceneSink &&) = delete;
+    SceneSink &operator=(SceneSink &&) = delete;
+    virtual ~SceneSink() = default;
+
+    virtual void begin(const SceneWorld &world) = 0;
+    virtual void add_bodies(const std::vector<SceneBody> &bodies) = 0;
+    virtual void add_spawner(const SceneSpawner &spawner) = 0;
+    virtual void add_destructible(const SceneDestructible &destructible) = 0;
+    virtual void end() = 0;
+};
+
+#endif
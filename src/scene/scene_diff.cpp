@@ -0,0 +1,177 @@
+#include "scene_diff.h"
+
+#include "physics/vec3.h"
+#include "scene.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+// 64-bit FNV-1a
+constexpr uint64_t kKeyOffsetBasis{14'695'981'039'346'656'037ULL};
+constexpr uint64_t kKeyPrime{1'099'511'628'211ULL};
+
+void hash(SceneBodyKey &key, const uint32_t value)
+{
+    for (uint32_t shift{0}; shift < 32; shift += 8)
+    {
+        key ^= (value >> shift) & 0xFFU;
+        key *= kKeyPrime;
+    }
+}
+
+void hash(SceneBodyKey &key, const float value)
+{
+    // -0 and 0 compare equal, so they must hash the same
+    const float normalised{value == 0.F ? 0.F : value};
+    uint32_t bits{0};
+    std::memcpy(&bits, &normalised, sizeof(bits));
+    hash(key, bits);
+}
+
+void hash(SceneBodyKey &key, const Vec3 &vec3)
+{
+    hash(key, vec3.x);
+    hash(key, vec3.y);
+    hash(key, vec3.z);
+}
+
+void sorted_order(const std::vector<SceneBodyKey> &keys,
+                  std::vector<std::size_t> &order)
+{
+    order.resize(keys.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::sort(order.begin(),
+              order.end(),
+              [&keys](const std::size_t lhs, const std::size_t rhs)
+              { return keys[lhs] < keys[rhs]; });
+}
+} // namespace
+
+SceneBodyKey scene_body_key(const SceneBody &body)
+{
+    SceneBodyKey key{kKeyOffsetBasis};
+    hash(key, static_cast<uint32_t>(body.shape));
+    hash(key, static_cast<uint32_t>(body.motion));
+    hash(key, body.position);
+    hash(key, body.half_extents);
+    hash(key, body.radius);
+    hash(key, body.velocity);
+    hash(key, body.material.friction);
+    hash(key, body.material.restitution);
+    hash(key, static_cast<uint32_t>(body.ball));
+    return key;
+}
+
+void SceneKeyCollector::begin(const SceneWorld &world)
+{
+    _world = world;
+}
+
+void SceneKeyCollector::add_bodies(const std::vector<SceneBody> &bodies)
+{
+    for (const SceneBody &body : bodies)
+    {
+        _keys.push_back(scene_body_key(body));
+    }
+}
+
+void SceneKeyCollector::add_spawner(const SceneSpawner &spawner)
+{
+    _spawners.push_back(spawner);
+}
+
+void SceneKeyCollector::add_destructible(const SceneDestructible &destructible)
+{
+    _destructibles.push_back(destructible);
+}
+
+void SceneKeyCollector::end()
+{
+}
+
+const SceneWorld &SceneKeyCollector::world() const
+{
+    return _world;
+}
+
+const std::vector<SceneBodyKey> &SceneKeyCollector::keys() const
+{
+    return _keys;
+}
+
+const std::vector<SceneSpawner> &SceneKeyCollector::spawners() const
+{
+    return _spawners;
+}
+
+const std::vector<SceneDestructible> &SceneKeyCollector::destructibles() const
+{
+    return _destructibles;
+}
+
+bool operator==(const SceneWorld &lhs, const SceneWorld &rhs)
+{
+    return lhs.max_bodies == rhs.max_bodies &&
+           lhs.max_body_pairs == rhs.max_body_pairs &&
+           lhs.max_contact_constraints == rhs.max_contact_constraints &&
+           lhs.merge_cell == rhs.merge_cell;
+}
+
+bool operator!=(const SceneWorld &lhs, const SceneWorld &rhs)
+{
+    return !(lhs == rhs);
+}
+
+void diff_scene(const std::vector<SceneBodyKey> &current,
+                const std::vector<SceneBodyKey> &next,
+                SceneDiff &diff)
+{
+    diff.removed.clear();
+    diff.added.clear();
+    diff.kept.clear();
+
+    // Walk both scenes in key order, like merging two sorted lists
+    std::vector<std::size_t> current_order{};
+    std::vector<std::size_t> next_order{};
+    sorted_order(current, current_order);
+    sorted_order(next, next_order);
+    std::size_t current_index{0};
+    std::size_t next_index{0};
+    while (current_index < current_order.size() &&
+           next_index < next_order.size())
+    {
+        const SceneBodyKey current_key{current[current_order[current_index]]};
+        const SceneBodyKey next_key{next[next_order[next_index]]};
+        if (current_key < next_key)
+        {
+            diff.removed.push_back(current_order[current_index++]);
+        }
+        else if (next_key < current_key)
+        {
+            diff.added.push_back(next_order[next_index++]);
+        }
+        else
+        {
+            diff.kept.emplace_back(current_order[current_index++],
+                                   next_order[next_index++]);
+        }
+    }
+    for (; current_index < current_order.size(); ++current_index)
+    {
+        diff.removed.push_back(current_order[current_index]);
+    }
+    for (; next_index < next_order.size(); ++next_index)
+    {
+        diff.added.push_back(next_order[next_index]);
+    }
+
+    // Adding in file order keeps the rendered sphere order stable
+    std::sort(diff.removed.begin(), diff.removed.end());
+    std::sort(diff.added.begin(), diff.added.end());
+}
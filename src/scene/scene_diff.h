@@ -0,0 +1,62 @@
+#ifndef SRC_SCENE_SCENE_DIFF_H
+#define SRC_SCENE_SCENE_DIFF_H
+
+#include "scene.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// A 64-bit hash of everything a body's line describes. Scene reloads compare
+// bodies by key, so only eight bytes per body are kept rather than the whole
+// description.
+using SceneBodyKey = uint64_t;
+
+[[nodiscard]] SceneBodyKey scene_body_key(const SceneBody &body);
+
+// Keeps a parsed scene's world, spawners and destructibles, but only a key
+// for each body, so a reloaded file can be compared with the scene that is
+// already loaded before anything in the world changes
+class SceneKeyCollector final : public SceneSink
+{
+public:
+    void begin(const SceneWorld &world) override;
+    void add_bodies(const std::vector<SceneBody> &bodies) override;
+    void add_spawner(const SceneSpawner &spawner) override;
+    void add_destructible(const SceneDestructible &destructible) override;
+    void end() override;
+
+    [[nodiscard]] const SceneWorld &world() const;
+    // In file order
+    [[nodiscard]] const std::vector<SceneBodyKey> &keys() const;
+    [[nodiscard]] const std::vector<SceneSpawner> &spawners() const;
+    [[nodiscard]] const std::vector<SceneDestructible> &destructibles() const;
+
+private:
+    SceneWorld _world{};
+    std::vector<SceneBodyKey> _keys{};
+    std::vector<SceneSpawner> _spawners{};
+    std::vector<SceneDestructible> _destructibles{};
+};
+
+// Which bodies to remove from current and which to add from next. An
+// unchanged line keeps its body, wherever the simulation has moved it, and a
+// changed line replaces it. Duplicate lines are matched one to one.
+struct SceneDiff
+{
+    std::vector<std::size_t> removed{}; // indices into current, ascending
+    std::vector<std::size_t> added{};   // indices into next, ascending
+    // Matched current and next indices, in key order
+    std::vector<std::pair<std::size_t, std::size_t>> kept{};
+};
+
+[[nodiscard]] bool operator==(const SceneWorld &lhs, const SceneWorld &rhs);
+[[nodiscard]] bool operator!=(const SceneWorld &lhs, const SceneWorld &rhs);
+
+// Sorts both scenes' keys, so runs in O(n log n)
+void diff_scene(const std::vector<SceneBodyKey> &current,
+                const std::vector<SceneBodyKey> &next,
+                SceneDiff &diff);
+
+#endif
@@ -0,0 +1,546 @@
+#include "scene_loader.h"
+
+#include "physics/physics.h"
+#include "scene.h"
+#include "scene_diff.h"
+#include "static_merge.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Math/Quat.h>
+#include <Jolt/Math/Real.h>
+#include <Jolt/Math/Vec3.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Body/MotionType.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+#include <Jolt/Physics/Collision/Shape/StaticCompoundShape.h>
+#include <Jolt/Physics/Collision/Shape/SubShapeID.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace
+{
+JPH::Vec3 to_jolt(const Vec3 &vec3)
+{
+    return JPH::Vec3{vec3.x, vec3.y, vec3.z};
+}
+
+// User data 0 is what bodies get by default, so entities are stored one up to
+// tell scene bodies from the rest
+JPH::uint64 user_data_for(const uint32_t entity)
+{
+    return JPH::uint64{entity} + 1;
+}
+
+bool same_shape(const SceneBody &lhs, const SceneBody &rhs)
+{
+    if (lhs.shape != rhs.shape)
+    {
+        return false;
+    }
+    if (lhs.shape == SceneShape::Sphere)
+    {
+        return lhs.radius == rhs.radius;
+    }
+    return lhs.half_extents.x == rhs.half_extents.x &&
+           lhs.half_extents.y == rhs.half_extents.y &&
+           lhs.half_extents.z == rhs.half_extents.z;
+}
+} // namespace
+
+SceneLoader::SceneLoader(PhysicsEngine &physics_engine)
+    : _physics_engine{physics_engine}
+{
+}
+
+void SceneLoader::begin(const SceneWorld &world)
+{
+    _world = world;
+    PhysicsConfig config{physics_config_for(world.max_bodies)};
+    if (world.max_body_pairs != 0)
+    {
+        config.max_body_pairs = world.max_body_pairs;
+    }
+    if (world.max_contact_constraints != 0)
+    {
+        config.max_contact_constraints = world.max_contact_constraints;
+    }
+    _physics_engine.initialise(config);
+}
+
+class SceneLoader::ReloadSink final : public SceneSink
+{
+public:
+    explicit ReloadSink(SceneLoader &scene_loader)
+        : _scene_loader{scene_loader}
+    {
+    }
+
+    // The world, spawners and destructibles were taken from the first pass
+    void begin(const SceneWorld & /* world */) override
+    {
+    }
+
+    void add_bodies(const std::vector<SceneBody> &bodies) override
+    {
+        SceneLoader &loader{_scene_loader};
+        loader._batch.clear();
+        loader._batch_entities.clear();
+        for (const SceneBody &body : bodies)
+        {
+            if (_next_added < loader._diff.added.size() &&
+                loader._diff.added[_next_added] == _index)
+            {
+                loader._batch.push_back(body);
+                loader._batch_entities.push_back(
+                    loader._added_entities[_next_added]);
+                ++_next_added;
+            }
+            ++_index;
+        }
+        if (!loader._batch.empty())
+        {
+            loader.add_batch(loader._batch, loader._batch_entities);
+        }
+    }
+
+    void add_spawner(const SceneSpawner & /* spawner */) override
+    {
+    }
+
+    void add_destructible(
+        const SceneDestructible & /* destructible */) override
+    {
+    }
+
+    // reload merges the held back boxes itself, even if this pass fails
+    void end() override
+    {
+    }
+
+private:
+    SceneLoader &_scene_loader;
+    std::size_t _index{0};
+    std::size_t _next_added{0};
+};
+
+void SceneLoader::add_bodies(const std::vector<SceneBody> &bodies)
+{
+    _batch_entities.clear();
+    for (std::size_t index{0}; index < bodies.size(); ++index)
+    {
+        _batch_entities.push_back(_next_entity++);
+    }
+    add_batch(bodies, _batch_entities);
+}
+
+void SceneLoader::add_batch(const std::vector<SceneBody> &bodies,
+                            const std::vector<uint32_t> &entities)
+{
+    // The settings vectors keep their capacity, so after the first batch
+    // converting a batch only allocates the bodies' shapes
+    _settings.clear();
+    _settings.reserve(bodies.size());
+    _settings_sources.clear();
+    for (std::size_t index{0}; index < bodies.size(); ++index)
+    {
+        const SceneBody &body{bodies[index]};
+        const uint32_t entity{entities[index]};
+        if (merges(body))
+        {
+            _merge_bodies.push_back(body);
+            _merge_entities.push_back(entity);
+            continue;
+        }
+        push_settings(body, entity);
+        _settings_sources.push_back(index);
+    }
+    if (_settings.empty())
+    {
+        return;
+    }
+
+    _physics_engine.add_bodies(_settings, _batch_ids);
+
+    for (std::size_t index{0}; index < _settings.size(); ++index)
+    {
+        const JPH::BodyID &body_id{_batch_ids[index]};
+        if (body_id.IsInvalid())
+        {
+            continue;
+        }
+        record_body(bodies[_settings_sources[index]],
+                    body_id,
+                    static_cast<uint32_t>(_settings[index].mUserData - 1));
+    }
+}
+
+void SceneLoader::add_spawner(const SceneSpawner &spawner)
+{
+    _spawners.push_back(spawner);
+}
+
+void SceneLoader::add_destructible(const SceneDestructible &destructible)
+{
+    _destructibles.push_back(destructible);
+}
+
+void SceneLoader::end()
+{
+    if (_merge_bodies.empty())
+    {
+        return;
+    }
+
+    static_merge::cluster(_merge_bodies, _world.merge_cell, _clusters);
+    _settings.clear();
+    _settings.reserve(_clusters.clusters.size());
+    _settings_sources.clear();
+    for (std::size_t index{0}; index < _clusters.clusters.size(); ++index)
+    {
+        const StaticCluster &cluster{_clusters.clusters[index]};
+        if (cluster.count == 1)
+        {
+            const std::size_t member{_clusters.members[cluster.first]};
+            push_settings(_merge_bodies[member], _merge_entities[member]);
+        }
+        else if (!push_compound_settings(cluster))
+        {
+            continue;
+        }
+        _settings_sources.push_back(index);
+    }
+
+    _physics_engine.add_bodies(_settings, _batch_ids);
+
+    std::size_t merged_boxes{0};
+    std::size_t merged_bodies{0};
+    for (std::size_t index{0}; index < _settings.size(); ++index)
+    {
+        const JPH::BodyID &body_id{_batch_ids[index]};
+        if (body_id.IsInvalid())
+        {
+            continue;
+        }
+        const StaticCluster &cluster{
+            _clusters.clusters[_settings_sources[index]]};
+        for (std::size_t member_index{cluster.first};
+             member_index < cluster.first + cluster.count;
+             ++member_index)
+        {
+            const std::size_t member{_clusters.members[member_index]};
+            record_body(
+                _merge_bodies[member], body_id, _merge_entities[member]);
+        }
+        merged_boxes += cluster.count;
+        ++merged_bodies;
+    }
+    spdlog::info("Merged {} static boxes into {} bodies",
+                 merged_boxes,
+                 merged_bodies);
+
+    _merge_bodies.clear();
+    _merge_entities.clear();
+}
+
+const std::vector<SceneSphere> &SceneLoader::spheres() const
+{
+    return _spheres;
+}
+
+const std::vector<SceneSpawner> &SceneLoader::spawners() const
+{
+    return _spawners;
+}
+
+const std::vector<SceneDestructible> &SceneLoader::destructibles() const
+{
+    return _destructibles;
+}
+
+const JPH::BodyID &SceneLoader::ball() const
+{
+    return _ball;
+}
+
+std::size_t SceneLoader::body_count() const
+{
+    return _body_ids.size();
+}
+
+std::size_t SceneLoader::world_body_count() const
+{
+    // Boxes merged into one body are recorded together, and stay together as
+    // the vectors are compacted, so each run of one ID is one body
+    std::size_t count{0};
+    for (std::size_t index{0}; index < _body_ids.size(); ++index)
+    {
+        if (index == 0 || _body_ids[index] != _body_ids[index - 1])
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+bool SceneLoader::entity_for(const JPH::BodyID &body_id,
+                             const JPH::SubShapeID &sub_shape_id,
+                             uint32_t &entity) const
+{
+    JPH::uint64 user_data{0};
+    if (!_physics_engine.get_sub_shape_user_data(
+            body_id, sub_shape_id, user_data) ||
+        user_data == 0)
+    {
+        return false;
+    }
+    entity = static_cast<uint32_t>(user_data - 1);
+    return true;
+}
+
+bool SceneLoader::reload(
+    const std::function<bool(SceneSink &sink)> &parse_scene)
+{
+    SceneKeyCollector scene{};
+    if (!parse_scene(scene))
+    {
+        return false;
+    }
+    if (scene.world() != _world)
+    {
+        spdlog::warn("Scene world capacities change on restart");
+    }
+
+    diff_scene(_keys, scene.keys(), _diff);
+
+    // A merged box shares its compound with the other boxes in its cell, so
+    // removing one takes the whole compound out
+    _batch_ids.clear();
+    for (const std::size_t index : _diff.removed)
+    {
+        _batch_ids.push_back(_body_ids[index]);
+    }
+    std::sort(_batch_ids.begin(), _batch_ids.end());
+    _batch_ids.erase(std::unique(_batch_ids.begin(), _batch_ids.end()),
+                     _batch_ids.end());
+
+    // The boxes left in such a compound are unchanged, so they are removed
+    // with it and added again from the new file, keeping their entities, to be
+    // merged anew at end
+    std::size_t remerged{0};
+    _survivors.clear();
+    for (const auto &[current, next] : _diff.kept)
+    {
+        if (std::binary_search(
+                _batch_ids.begin(), _batch_ids.end(), _body_ids[current]))
+        {
+            _diff.removed.push_back(current);
+            _diff.added.push_back(next);
+            _survivors.emplace_back(next, _entities[current]);
+            ++remerged;
+        }
+    }
+    std::sort(_diff.removed.begin(), _diff.removed.end());
+    std::sort(_diff.added.begin(), _diff.added.end());
+    std::sort(_survivors.begin(), _survivors.end());
+
+    // New bodies are numbered in file order, as on a first load
+    _added_entities.clear();
+    std::size_t next_survivor{0};
+    for (const std::size_t index : _diff.added)
+    {
+        if (next_survivor < _survivors.size() &&
+            _survivors[next_survivor].first == index)
+        {
+            _added_entities.push_back(_survivors[next_survivor++].second);
+            continue;
+        }
+        _added_entities.push_back(_next_entity++);
+    }
+
+    // Removed indices are sorted, so one pass compacts the vectors
+    std::size_t kept{0};
+    std::size_t next_removed{0};
+    for (std::size_t index{0}; index < _keys.size(); ++index)
+    {
+        if (next_removed < _diff.removed.size() &&
+            _diff.removed[next_removed] == index)
+        {
+            ++next_removed;
+            if (_body_ids[index] == _ball)
+            {
+                _ball = JPH::BodyID{};
+            }
+            continue;
+        }
+        _keys[kept] = _keys[index];
+        _body_ids[kept] = _body_ids[index];
+        _entities[kept] = _entities[index];
+        _sphere_radii[kept] = _sphere_radii[index];
+        ++kept;
+    }
+    _keys.resize(kept);
+    _body_ids.resize(kept);
+    _entities.resize(kept);
+    _sphere_radii.resize(kept);
+    _physics_engine.remove_bodies(_batch_ids);
+
+    // add_bodies appends to the spheres, so start from the kept ones
+    rebuild_spheres();
+    ReloadSink sink{*this};
+    if (!parse_scene(sink))
+    {
+        spdlog::warn("The scene could not be read again to add its new "
+                     "bodies");
+    }
+    end();
+
+    _spawners = scene.spawners();
+    _destructibles = scene.destructibles();
+    spdlog::info("Scene reloaded: {} bodies kept, {} removed, {} added",
+                 _diff.kept.size() - remerged,
+                 _diff.removed.size() - remerged,
+                 _diff.added.size() - remerged);
+    return true;
+}
+
+bool SceneLoader::merges(const SceneBody &body) const
+{
+    return _world.merge_cell > 0.F && body.shape == SceneShape::Box &&
+           body.motion == SceneMotion::Static;
+}
+
+void SceneLoader::push_settings(const SceneBody &body, const uint32_t entity)
+{
+    const bool is_static{body.motion == SceneMotion::Static};
+    JPH::BodyCreationSettings &settings{_settings.emplace_back(
+        shape_for(body),
+        JPH::RVec3{body.position.x, body.position.y, body.position.z},
+        JPH::Quat::sIdentity(),
+        is_static ? JPH::EMotionType::Static : JPH::EMotionType::Dynamic,
+        is_static ? Layers::NON_MOVING : Layers::MOVING)};
+    settings.mLinearVelocity = to_jolt(body.velocity);
+    settings.mFriction = body.material.friction;
+    settings.mRestitution = body.material.restitution;
+    settings.mUserData = user_data_for(entity);
+}
+
+bool SceneLoader::push_compound_settings(const StaticCluster &cluster)
+{
+    // The body sits at the centre of its boxes, which keeps the sub-shape
+    // offsets small
+    const SceneBody &first{
+        _merge_bodies[_clusters.members[cluster.first]]};
+    Vec3 lowest{first.position};
+    Vec3 highest{first.position};
+    for (std::size_t index{cluster.first}; index < cluster.first + cluster.count;
+         ++index)
+    {
+        const Vec3 &position{_merge_bodies[_clusters.members[index]].position};
+        lowest = Vec3{std::min(lowest.x, position.x),
+                      std::min(lowest.y, position.y),
+                      std::min(lowest.z, position.z)};
+        highest = Vec3{std::max(highest.x, position.x),
+                       std::max(highest.y, position.y),
+                       std::max(highest.z, position.z)};
+    }
+    const Vec3 centre{(lowest.x + highest.x) * 0.5F,
+                      (lowest.y + highest.y) * 0.5F,
+                      (lowest.z + highest.z) * 0.5F};
+
+    // Each sub-shape carries its box's entity, which is what entity_for reads
+    // back from a hit's sub-shape ID
+    JPH::StaticCompoundShapeSettings compound{};
+    for (std::size_t index{cluster.first}; index < cluster.first + cluster.count;
+         ++index)
+    {
+        const std::size_t member{_clusters.members[index]};
+        const SceneBody &body{_merge_bodies[member]};
+        compound.AddShape(JPH::Vec3{body.position.x - centre.x,
+                                    body.position.y - centre.y,
+                                    body.position.z - centre.z},
+                          JPH::Quat::sIdentity(),
+                          shape_for(body).GetPtr(),
+                          static_cast<uint32_t>(
+                              user_data_for(_merge_entities[member])));
+    }
+    const JPH::ShapeSettings::ShapeResult result{compound.Create()};
+    if (result.HasError())
+    {
+        spdlog::error("Unable to merge {} static boxes: {}",
+                      cluster.count,
+                      result.GetError());
+        return false;
+    }
+
+    JPH::BodyCreationSettings &settings{_settings.emplace_back(
+        result.Get(),
+        JPH::RVec3{centre.x, centre.y, centre.z},
+        JPH::Quat::sIdentity(),
+        JPH::EMotionType::Static,
+        Layers::NON_MOVING)};
+    settings.mFriction = first.material.friction;
+    settings.mRestitution = first.material.restitution;
+    return true;
+}
+
+void SceneLoader::record_body(const SceneBody &body,
+                              const JPH::BodyID &body_id,
+                              const uint32_t entity)
+{
+    _keys.push_back(scene_body_key(body));
+    _body_ids.push_back(body_id);
+    _entities.push_back(entity);
+    _sphere_radii.push_back(body.shape == SceneShape::Sphere ? body.radius
+                                                             : 0.F);
+    if (body.shape == SceneShape::Sphere)
+    {
+        _spheres.push_back(SceneSphere{body_id, body.radius});
+    }
+    if (body.ball)
+    {
+        _physics_engine.set_ball(body_id);
+        _ball = body_id;
+    }
+}
+
+void SceneLoader::rebuild_spheres()
+{
+    _spheres.clear();
+    for (std::size_t index{0}; index < _body_ids.size(); ++index)
+    {
+        if (_sphere_radii[index] > 0.F)
+        {
+            _spheres.push_back(
+                SceneSphere{_body_ids[index], _sphere_radii[index]});
+        }
+    }
+}
+
+JPH::ShapeRefC SceneLoader::shape_for(const SceneBody &body)
+{
+    if (_last_shape != nullptr && same_shape(body, _last_shape_body))
+    {
+        return _last_shape;
+    }
+    if (body.shape == SceneShape::Sphere)
+    {
+        _last_shape = new JPH::SphereShape{body.radius};
+    }
+    else
+    {
+        _last_shape = new JPH::BoxShape{to_jolt(body.half_extents)};
+    }
+    _last_shape_body = body;
+    return _last_shape;
+}
@@ -0,0 +1,134 @@
+#ifndef SRC_SCENE_SCENE_LOADER_H
+#define SRC_SCENE_SCENE_LOADER_H
+
+#include "physics/physics.h"
+#include "scene.h"
+#include "scene_diff.h"
+#include "static_merge.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+#include <Jolt/Physics/Collision/Shape/SubShapeID.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// A sphere the game draws, and the radius to draw it at
+struct SceneSphere
+{
+    JPH::BodyID id;
+    float radius;
+};
+
+// Builds a parsed scene in a PhysicsEngine. begin initialises the engine with
+// the scene's capacities, and each batch of bodies is added to the world in
+// one go. Does not optimise the broad phase, so call start_simulation once the
+// whole scene is in. A reloaded scene is applied as a diff against the bodies
+// already loaded, which are remembered by key rather than by description.
+//
+// When the world sets a merge_cell, static boxes are held back until end and
+// each cell's boxes become one StaticCompoundShape body, which keeps the
+// static broad phase tree small for levels built from many boxes. Every
+// scene body gets an entity number, counting up in the order bodies arrive,
+// so a hit on a merged body can still be traced to the box it hit.
+class SceneLoader final : public SceneSink
+{
+public:
+    explicit SceneLoader(PhysicsEngine &physics_engine);
+
+    void begin(const SceneWorld &world) override;
+    void add_bodies(const std::vector<SceneBody> &bodies) override;
+    void add_spawner(const SceneSpawner &spawner) override;
+    // Destructibles are built by DestructibleSystem, the loader only keeps
+    // them
+    void add_destructible(const SceneDestructible &destructible) override;
+    // Creates the merged static bodies
+    void end() override;
+
+    // Brings the world in line with a reloaded scene, removing the bodies whose
+    // lines went away or changed and adding the new ones. Unchanged bodies are
+    // left as they are. World capacities only change on restart.
+    //
+    // parse_scene streams the scene into the sink it is given, and is called
+    // twice: first to key every body, then to add the bodies that are new.
+    // Neither pass holds more than a batch of bodies, so a reload needs eight
+    // bytes per body on top of the batch. Returns false, having changed
+    // nothing, if the first pass fails.
+    bool reload(const std::function<bool(SceneSink &sink)> &parse_scene);
+
+    [[nodiscard]] const std::vector<SceneSphere> &spheres() const;
+    [[nodiscard]] const std::vector<SceneSpawner> &spawners() const;
+    [[nodiscard]] const std::vector<SceneDestructible> &destructibles() const;
+    // Invalid when the scene has no ball
+    [[nodiscard]] const JPH::BodyID &ball() const;
+    // Scene bodies in the world, not counting any the world had no room for.
+    // Merged boxes count one each.
+    [[nodiscard]] std::size_t body_count() const;
+    // Physics bodies the scene bodies were built as
+    [[nodiscard]] std::size_t world_body_count() const;
+    // The entity a contact or query hit on a scene body belongs to. False for
+    // bodies the scene did not create, such as spawned ones.
+    [[nodiscard]] bool entity_for(const JPH::BodyID &body_id,
+                                  const JPH::SubShapeID &sub_shape_id,
+                                  uint32_t &entity) const;
+
+private:
+    // Forwards the bodies a reload adds, and nothing else, to the loader
+    class ReloadSink;
+
+    // Adds a batch of bodies with the given entity numbers
+    void add_batch(const std::vector<SceneBody> &bodies,
+                   const std::vector<uint32_t> &entities);
+    [[nodiscard]] bool merges(const SceneBody &body) const;
+    // Appends creation settings for one body to _settings
+    void push_settings(const SceneBody &body, uint32_t entity);
+    // Builds one compound from a cluster of _merge_bodies. False, with an
+    // error logged, if Jolt rejects it.
+    bool push_compound_settings(const StaticCluster &cluster);
+    void record_body(const SceneBody &body,
+                     const JPH::BodyID &body_id,
+                     uint32_t entity);
+    // Consecutive bodies of the same size share one shape
+    JPH::ShapeRefC shape_for(const SceneBody &body);
+    void rebuild_spheres();
+
+    PhysicsEngine &_physics_engine;
+    SceneWorld _world{};
+    std::vector<JPH::BodyCreationSettings> _settings{};
+    // Per settings entry, the body or cluster it was made from
+    std::vector<std::size_t> _settings_sources{};
+    JPH::BodyIDVector _batch_ids{};
+    // The loaded bodies' keys, IDs, entities and sphere radii, zero for
+    // boxes. Merged boxes share their compound's ID.
+    std::vector<SceneBodyKey> _keys{};
+    JPH::BodyIDVector _body_ids{};
+    std::vector<uint32_t> _entities{};
+    std::vector<float> _sphere_radii{};
+    uint32_t _next_entity{0};
+    // Static boxes waiting for end
+    std::vector<SceneBody> _merge_bodies{};
+    std::vector<uint32_t> _merge_entities{};
+    StaticClusters _clusters{};
+    std::vector<SceneSphere> _spheres{};
+    SceneDiff _diff{};
+    // Entities for the bodies a reload adds, in the order of _diff.added, and
+    // the next index and entity of each merged box a reload takes out and adds
+    // back
+    std::vector<uint32_t> _added_entities{};
+    std::vector<std::pair<std::size_t, uint32_t>> _survivors{};
+    std::vector<SceneBody> _batch{};
+    std::vector<uint32_t> _batch_entities{};
+    std::vector<SceneSpawner> _spawners{};
+    std::vector<SceneDestructible> _destructibles{};
+    JPH::BodyID _ball{};
+    JPH::ShapeRefC _last_shape{};
+    SceneBody _last_shape_body{};
+};
+
+#endif
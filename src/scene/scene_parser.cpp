@@ -0,0 +1,477 @@
+#include "scene_parser.h"
+
+#include "physics/vec3.h"
+#include "scene.h"
+#include "text_fields.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+using text_fields::parse_float;
+using text_fields::parse_unsigned;
+
+class LineParser
+{
+public:
+    LineParser(const std::vector<std::string_view> &tokens,
+               const std::map<std::string, SceneMaterial, std::less<>> &materials)
+        : _tokens{tokens}, _materials{materials}
+    {
+    }
+
+    [[nodiscard]] const char *error() const
+    {
+        return _error;
+    }
+
+    bool parse_world(SceneWorld &world)
+    {
+        for (_index = 1; _index < _tokens.size() && _error == nullptr;)
+        {
+            const std::string_view key{_tokens[_index++]};
+            if (key == "bodies")
+            {
+                read_unsigned(world.max_bodies);
+            }
+            else if (key == "pairs")
+            {
+                read_unsigned(world.max_body_pairs);
+            }
+            else if (key == "contacts")
+            {
+                read_unsigned(world.max_contact_constraints);
+            }
+            else if (key == "merge_cell")
+            {
+                read_float(world.merge_cell);
+            }
+            else
+            {
+                _error = "unknown world setting";
+            }
+        }
+        if (_error == nullptr && world.merge_cell < 0.F)
+        {
+            _error = "merge_cell must not be negative";
+        }
+        return _error == nullptr;
+    }
+
+    bool parse_material(std::string &name, SceneMaterial &material)
+    {
+        if (_tokens.size() < 2)
+        {
+            _error = "material needs a name";
+            return false;
+        }
+        name = _tokens[1];
+        for (_index = 2; _index < _tokens.size() && _error == nullptr;)
+        {
+            const std::string_view key{_tokens[_index++]};
+            if (key == "friction")
+            {
+                read_float(material.friction);
+            }
+            else if (key == "restitution")
+            {
+                read_float(material.restitution);
+            }
+            else
+            {
+                _error = "unknown material setting";
+            }
+        }
+        return _error == nullptr;
+    }
+
+    bool parse_body(const SceneShape shape, SceneBody &body)
+    {
+        body.shape = shape;
+        if (_tokens.size() < 2 ||
+            (_tokens[1] != "static" && _tokens[1] != "dynamic"))
+        {
+            _error = "expected static or dynamic";
+            return false;
+        }
+        body.motion = _tokens[1] == "static" ? SceneMotion::Static
+                                             : SceneMotion::Dynamic;
+        bool has_position{false};
+        bool has_size{false};
+        for (_index = 2; _index < _tokens.size() && _error == nullptr;)
+        {
+            const std::string_view key{_tokens[_index++]};
+            if (key == "position")
+            {
+                has_position = read_vec3(body.position);
+            }
+            else if (key == "half_extents" && shape == SceneShape::Box)
+            {
+                has_size = read_vec3(body.half_extents);
+            }
+            else if (key == "radius" && shape == SceneShape::Sphere)
+            {
+                has_size = read_float(body.radius);
+            }
+            else if (key == "velocity")
+            {
+                read_vec3(body.velocity);
+            }
+            else if (key == "material")
+            {
+                read_material(body.material);
+            }
+            else if (key == "ball")
+            {
+                body.ball = true;
+            }
+            else
+            {
+                _error = "unknown body setting";
+            }
+        }
+        if (_error == nullptr && (!has_position || !has_size))
+        {
+            _error = shape == SceneShape::Box
+                         ? "box needs position and half_extents"
+                         : "sphere needs position and radius";
+        }
+        if (_error == nullptr &&
+            (body.radius <= 0.F || body.half_extents.x <= 0.F ||
+             body.half_extents.y <= 0.F || body.half_extents.z <= 0.F))
+        {
+            _error = "sizes must be positive";
+        }
+        return _error == nullptr;
+    }
+
+    bool parse_spawner(SceneSpawner &spawner)
+    {
+        bool has_position{false};
+        for (_index = 1; _index < _tokens.size() && _error == nullptr;)
+        {
+            const std::string_view key{_tokens[_index++]};
+            if (key == "position")
+            {
+                has_position = read_vec3(spawner.position);
+            }
+            else if (key == "area")
+            {
+                read_vec3(spawner.area);
+            }
+            else if (key == "velocity")
+            {
+                read_vec3(spawner.velocity);
+            }
+            else if (key == "velocity_spread")
+            {
+                read_vec3(spawner.velocity_spread);
+            }
+            else if (key == "radius")
+            {
+                read_float(spawner.radius);
+            }
+            else if (key == "lifetime")
+            {
+                read_float(spawner.lifetime);
+            }
+            else if (key == "kill_y")
+            {
+                read_float(spawner.kill_y);
+            }
+            else if (key == "rate")
+            {
+                read_float(spawner.rate);
+            }
+            else if (key == "limit")
+            {
+                read_unsigned(spawner.limit);
+            }
+            else if (key == "material")
+            {
+                read_material(spawner.material);
+            }
+            else
+            {
+                _error = "unknown spawner setting";
+            }
+        }
+        if (_error == nullptr && !has_position)
+        {
+            _error = "spawner needs a position";
+        }
+        if (_error == nullptr && (spawner.radius <= 0.F || spawner.rate <= 0.F))
+        {
+            _error = "radius and rate must be positive";
+        }
+        if (_error == nullptr && spawner.lifetime < 0.F)
+        {
+            _error = "lifetime must not be negative";
+        }
+        return _error == nullptr;
+    }
+
+    bool parse_destructible(SceneDestructible &destructible)
+    {
+        if (_tokens.size() < 2 ||
+            (_tokens[1] != "static" && _tokens[1] != "dynamic"))
+        {
+            _error = "expected static or dynamic";
+            return false;
+        }
+        destructible.motion = _tokens[1] == "static" ? SceneMotion::Static
+                                                     : SceneMotion::Dynamic;
+        bool has_position{false};
+        for (_index = 2; _index < _tokens.size() && _error == nullptr;)
+        {
+            const std::string_view key{_tokens[_index++]};
+            if (key == "position")
+            {
+                has_position = read_vec3(destructible.position);
+            }
+            else if (key == "parts")
+            {
+                if (read_unsigned(destructible.parts_x) &&
+                    read_unsigned(destructible.parts_y))
+                {
+                    read_unsigned(destructible.parts_z);
+                }
+            }
+            else if (key == "part_radius")
+            {
+                read_float(destructible.part_radius);
+            }
+            else if (key == "threshold")
+            {
+                read_float(destructible.threshold);
+            }
+            else if (key == "detach")
+            {
+                destructible.detach = true;
+            }
+            else if (key == "material")
+            {
+                read_material(destructible.material);
+            }
+            else
+            {
+                _error = "unknown destructible setting";
+            }
+        }
+        if (_error == nullptr && !has_position)
+        {
+            _error = "destructible needs a position";
+        }
+        if (_error == nullptr &&
+            (destructible.parts_x == 0 || destructible.parts_y == 0 ||
+             destructible.parts_z == 0))
+        {
+            _error = "a destructible needs at least one part";
+        }
+        if (_error == nullptr && (destructible.part_radius <= 0.F ||
+                                  destructible.threshold <= 0.F))
+        {
+            _error = "part_radius and threshold must be positive";
+        }
+        return _error == nullptr;
+    }
+
+private:
+    bool next(std::string_view &token)
+    {
+        if (_index >= _tokens.size())
+        {
+            _error = "missing value";
+            return false;
+        }
+        token = _tokens[_index++];
+        return true;
+    }
+
+    bool read_float(float &value)
+    {
+        std::string_view token{};
+        if (next(token) && !parse_float(token, value))
+        {
+            _error = "expected a number";
+        }
+        return _error == nullptr;
+    }
+
+    bool read_unsigned(uint32_t &value)
+    {
+        std::string_view token{};
+        if (next(token) && !parse_unsigned(token, value))
+        {
+            _error = "expected a whole number";
+        }
+        return _error == nullptr;
+    }
+
+    bool read_vec3(Vec3 &value)
+    {
+        return read_float(value.x) && read_float(value.y) &&
+               read_float(value.z);
+    }
+
+    bool read_material(SceneMaterial &material)
+    {
+        std::string_view name{};
+        if (!next(name))
+        {
+            return false;
+        }
+        const auto found{_materials.find(name)};
+        if (found == _materials.end())
+        {
+            _error = "unknown material";
+            return false;
+        }
+        material = found->second;
+        return true;
+    }
+
+    const std::vector<std::string_view> &_tokens;
+    const std::map<std::string, SceneMaterial, std::less<>> &_materials;
+    std::size_t _index{0};
+    const char *_error{nullptr};
+};
+} // namespace
+
+namespace scene_parser
+{
+bool parse(std::istream &stream,
+           const std::string_view source_name,
+           SceneSink &sink,
+           const std::size_t batch_size)
+{
+    std::map<std::string, SceneMaterial, std::less<>> materials{};
+    std::vector<SceneBody> batch{};
+    batch.reserve(batch_size);
+    std::vector<std::string_view> tokens{};
+    std::string line{};
+    std::size_t line_number{0};
+    bool begun{false};
+    const auto begin{[&](const SceneWorld &world)
+                     {
+                         if (!begun)
+                         {
+                             sink.begin(world);
+                             begun = true;
+                         }
+                     }};
+    const auto fail{[&](const char *error)
+                    {
+                        spdlog::error("{}:{}: {}", source_name, line_number, error);
+                        return false;
+                    }};
+
+    while (std::getline(stream, line))
+    {
+        ++line_number;
+        text_fields::tokenise(line, tokens);
+        if (tokens.empty())
+        {
+            continue;
+        }
+
+        LineParser parser{tokens, materials};
+        const std::string_view keyword{tokens.front()};
+        if (keyword == "world")
+        {
+            if (begun)
+            {
+                return fail("world must come before any body or spawner");
+            }
+            SceneWorld world{};
+            if (!parser.parse_world(world))
+            {
+                return fail(parser.error());
+            }
+            begin(world);
+        }
+        else if (keyword == "material")
+        {
+            std::string name{};
+            SceneMaterial material{};
+            if (!parser.parse_material(name, material))
+            {
+                return fail(parser.error());
+            }
+            materials[name] = material;
+        }
+        else if (keyword == "box" || keyword == "sphere")
+        {
+            SceneBody body{};
+            if (!parser.parse_body(keyword == "box" ? SceneShape::Box
+                                                    : SceneShape::Sphere,
+                                   body))
+            {
+                return fail(parser.error());
+            }
+            begin(SceneWorld{});
+            batch.push_back(body);
+            if (batch.size() >= batch_size)
+            {
+                sink.add_bodies(batch);
+                batch.clear();
+            }
+        }
+        else if (keyword == "spawner")
+        {
+            SceneSpawner spawner{};
+            if (!parser.parse_spawner(spawner))
+            {
+                return fail(parser.error());
+            }
+            begin(SceneWorld{});
+            sink.add_spawner(spawner);
+        }
+        else if (keyword == "destructible")
+        {
+            SceneDestructible destructible{};
+            if (!parser.parse_destructible(destructible))
+            {
+                return fail(parser.error());
+            }
+            begin(SceneWorld{});
+            sink.add_destructible(destructible);
+        }
+        else
+        {
+            return fail("unknown keyword");
+        }
+    }
+
+    begin(SceneWorld{});
+    if (!batch.empty())
+    {
+        sink.add_bodies(batch);
+    }
+    sink.end();
+    return true;
+}
+
+bool parse_file(const std::filesystem::path &path,
+                SceneSink &sink,
+                const std::size_t batch_size)
+{
+    std::ifstream stream{path};
+    if (!stream)
+    {
+        spdlog::error("Unable to read scene {}", path.string());
+        return false;
+    }
+    return parse(stream, path.string(), sink, batch_size);
+}
+} // namespace scene_parser
@@ -0,0 +1,45 @@
+#ifndef SRC_SCENE_SCENE_PARSER_H
+#define SRC_SCENE_SCENE_PARSER_H
+
+#include "scene.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <istream>
+#include <string_view>
+
+// Scene files are line based. Each line is a keyword followed by named
+// values, in any order, and # starts a comment:
+//
+//   world bodies <n> [pairs <n>] [contacts <n>] [merge_cell <size>]
+//   material <name> [friction <f>] [restitution <f>]
+//   box <static|dynamic> position <x y z> half_extents <x y z>
+//       [velocity <x y z>] [material <name>]
+//   sphere <static|dynamic> position <x y z> radius <r>
+//       [velocity <x y z>] [material <name>] [ball]
+//   spawner position <x y z> [area <x y z>] [velocity <x y z>]
+//       [velocity_spread <x y z>] [radius <r>] [rate <n>] [limit <n>]
+//       [lifetime <seconds>] [kill_y <y>] [material <name>]
+//   destructible <static|dynamic> position <x y z> [parts <x y z>]
+//       [part_radius <r>] [threshold <impulse>] [detach] [material <name>]
+//
+// The world line, if any, must come before the first body. A material applies
+// to the bodies after it that name it.
+namespace scene_parser
+{
+constexpr std::size_t kDefaultBatchSize{4'096};
+
+// Streams the scene into sink, handing over bodies in batches of batch_size
+// as they are read. Only the current line and one batch are held in memory,
+// so scene size does not limit what can be loaded. Stops at the first error,
+// which is logged with its line number, in which case end is not called.
+bool parse(std::istream &stream,
+           std::string_view source_name,
+           SceneSink &sink,
+           std::size_t batch_size = kDefaultBatchSize);
+bool parse_file(const std::filesystem::path &path,
+                SceneSink &sink,
+                std::size_t batch_size = kDefaultBatchSize);
+} // namespace scene_parser
+
+#endif
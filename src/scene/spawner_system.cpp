@@ -0,0 +1,234 @@
+#include "spawner_system.h"
+
+#include "physics/physics.h"
+#include "physics/vec3.h"
+#include "random.h"
+#include "scene.h"
+#include "scene_loader.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Math/Quat.h>
+#include <Jolt/Math/Real.h>
+#include <Jolt/Math/Vec3.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Body/MotionType.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace
+{
+// Marks bodies whose spawner went away in a reload
+constexpr std::size_t kNoSpawner{std::numeric_limits<std::size_t>::max()};
+constexpr float kRateWindowSeconds{1.F};
+} // namespace
+
+SpawnerSystem::SpawnerSystem(PhysicsEngine &physics_engine,
+                             const uint32_t seed)
+    : _physics_engine{physics_engine}, _generator{seed}
+{
+}
+
+void SpawnerSystem::set_spawners(const std::vector<SceneSpawner> &spawners)
+{
+    _spawners = spawners;
+    _shapes.clear();
+    for (const SceneSpawner &spawner : _spawners)
+    {
+        _shapes.emplace_back(new JPH::SphereShape{spawner.radius});
+    }
+    _due.assign(_spawners.size(), 0.F);
+    _alive.assign(_spawners.size(), 0);
+    for (Spawned &spawned : _spawned)
+    {
+        if (spawned.spawner < _spawners.size())
+        {
+            ++_alive[spawned.spawner];
+        }
+        else
+        {
+            spawned.spawner = kNoSpawner;
+        }
+    }
+
+    // Reserving for the most bodies the spawners can have alive means
+    // steady-state updates do not grow these vectors
+    const std::size_t most_alive{capacity() + _spawned.size()};
+    _spheres.reserve(most_alive);
+    _spawned.reserve(most_alive);
+    _settings.reserve(capacity());
+    _settings_spawner.reserve(capacity());
+    _body_ids.reserve(most_alive);
+}
+
+void SpawnerSystem::update(const float delta_time)
+{
+    const auto start{std::chrono::steady_clock::now()};
+    despawn(delta_time);
+    spawn(delta_time);
+    _stats.churn_milliseconds = std::chrono::duration<float, std::milli>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count();
+    _stats.live_bodies = _spawned.size();
+    update_rates(delta_time);
+}
+
+void SpawnerSystem::clear()
+{
+    _body_ids.clear();
+    for (const SceneSphere &sphere : _spheres)
+    {
+        _body_ids.push_back(sphere.id);
+    }
+    _physics_engine.remove_bodies(_body_ids);
+    _stats.despawned_total += _spheres.size();
+    _spheres.clear();
+    _spawned.clear();
+    _alive.assign(_spawners.size(), 0);
+    _stats.live_bodies = 0;
+}
+
+const std::vector<SceneSphere> &SpawnerSystem::spheres() const
+{
+    return _spheres;
+}
+
+std::size_t SpawnerSystem::capacity() const
+{
+    std::size_t total{0};
+    for (const SceneSpawner &spawner : _spawners)
+    {
+        total += spawner.limit;
+    }
+    return total;
+}
+
+const SpawnerStats &SpawnerSystem::stats() const
+{
+    return _stats;
+}
+
+void SpawnerSystem::despawn(const float delta_time)
+{
+    // One pass finds the expired bodies and compacts the survivors, then they
+    // all leave the world in a single batch
+    _body_ids.clear();
+    std::size_t kept{0};
+    for (std::size_t index{0}; index < _spawned.size(); ++index)
+    {
+        Spawned &spawned{_spawned[index]};
+        spawned.age += delta_time;
+        Vec3 position{0.F, 0.F, 0.F};
+        const bool expired{
+            !_physics_engine.get_body_position(_spheres[index].id, position) ||
+            position.y < spawned.kill_y ||
+            (spawned.lifetime > 0.F && spawned.age > spawned.lifetime)};
+        if (expired)
+        {
+            _body_ids.push_back(_spheres[index].id);
+            if (spawned.spawner != kNoSpawner)
+            {
+                --_alive[spawned.spawner];
+            }
+            continue;
+        }
+        _spheres[kept] = _spheres[index];
+        _spawned[kept] = spawned;
+        ++kept;
+    }
+    _spheres.resize(kept);
+    _spawned.resize(kept);
+
+    _stats.despawned_last_update = static_cast<uint32_t>(_body_ids.size());
+    _stats.despawned_total += _body_ids.size();
+    _window_despawned += _body_ids.size();
+    _physics_engine.remove_bodies(_body_ids);
+}
+
+void SpawnerSystem::spawn(const float delta_time)
+{
+    _settings.clear();
+    _settings_spawner.clear();
+    for (std::size_t index{0}; index < _spawners.size(); ++index)
+    {
+        const SceneSpawner &spawner{_spawners[index]};
+        _due[index] += spawner.rate * delta_time;
+        const auto due{static_cast<uint32_t>(std::floor(_due[index]))};
+        _due[index] -= static_cast<float>(due);
+        // Spawns held back by the limit are dropped rather than saved up, so
+        // a spawner at its limit does not burst when bodies despawn
+        const uint32_t room{spawner.limit > _alive[index]
+                                ? spawner.limit - _alive[index]
+                                : 0};
+        const uint32_t count{due < room ? due : room};
+
+        for (uint32_t spawned{0}; spawned < count; ++spawned)
+        {
+            const Vec3 &area{spawner.area};
+            const Vec3 &spread{spawner.velocity_spread};
+            JPH::BodyCreationSettings &settings{_settings.emplace_back(
+                _shapes[index],
+                JPH::RVec3{
+                    spawner.position.x + area.x * next_signed_unit(_generator),
+                    spawner.position.y + area.y * next_signed_unit(_generator),
+                    spawner.position.z + area.z * next_signed_unit(_generator)},
+                JPH::Quat::sIdentity(),
+                JPH::EMotionType::Dynamic,
+                Layers::MOVING)};
+            settings.mLinearVelocity = JPH::Vec3{
+                spawner.velocity.x + spread.x * next_signed_unit(_generator),
+                spawner.velocity.y + spread.y * next_signed_unit(_generator),
+                spawner.velocity.z + spread.z * next_signed_unit(_generator)};
+            settings.mFriction = spawner.material.friction;
+            settings.mRestitution = spawner.material.restitution;
+            _settings_spawner.push_back(index);
+        }
+    }
+
+    _stats.spawned_last_update = 0;
+    if (_settings.empty())
+    {
+        return;
+    }
+    _physics_engine.add_bodies(_settings, _body_ids);
+    for (std::size_t index{0}; index < _body_ids.size(); ++index)
+    {
+        if (_body_ids[index].IsInvalid())
+        {
+            ++_stats.failed_total;
+            continue;
+        }
+        const std::size_t spawner_index{_settings_spawner[index]};
+        const SceneSpawner &spawner{_spawners[spawner_index]};
+        _spheres.push_back(SceneSphere{_body_ids[index], spawner.radius});
+        _spawned.push_back(
+            Spawned{0.F, spawner.lifetime, spawner.kill_y, spawner_index});
+        ++_alive[spawner_index];
+        ++_stats.spawned_last_update;
+    }
+    _stats.spawned_total += _stats.spawned_last_update;
+    _window_spawned += _stats.spawned_last_update;
+}
+
+void SpawnerSystem::update_rates(const float delta_time)
+{
+    _window_seconds += delta_time;
+    if (_window_seconds < kRateWindowSeconds)
+    {
+        return;
+    }
+    _stats.spawned_per_second =
+        static_cast<float>(_window_spawned) / _window_seconds;
+    _stats.despawned_per_second =
+        static_cast<float>(_window_despawned) / _window_seconds;
+    _window_seconds = 0.F;
+    _window_spawned = 0;
+    _window_despawned = 0;
+}
@@ -0,0 +1,92 @@
+#ifndef SRC_SCENE_SPAWNER_SYSTEM_H
+#define SRC_SCENE_SPAWNER_SYSTEM_H
+
+#include "physics/physics.h"
+#include "scene.h"
+#include "scene_loader.h"
+
+#include <Jolt/Jolt.h> // NOLINT [misc-include-cleaner]
+
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Throughput numbers for stress runs. Per second rates cover the last whole
+// second of simulated time.
+struct SpawnerStats
+{
+    std::size_t live_bodies{0};
+    uint64_t spawned_total{0};
+    uint64_t despawned_total{0};
+    // Spawns skipped because the world had no room for them
+    uint64_t failed_total{0};
+    uint32_t spawned_last_update{0};
+    uint32_t despawned_last_update{0};
+    float spawned_per_second{0.F};
+    float despawned_per_second{0.F};
+    // Time update spent adding and removing bodies
+    float churn_milliseconds{0.F};
+};
+
+// Runs a scene's spawners. Each update despawns every spawned body that has
+// fallen below its kill plane or outlived its lifetime in one batched remove,
+// then creates the bodies due from all spawners in one batched add. Call it
+// between physics steps.
+class SpawnerSystem
+{
+public:
+    static constexpr uint32_t kDefaultSeed{20'240'601};
+
+    explicit SpawnerSystem(PhysicsEngine &physics_engine,
+                           uint32_t seed = kDefaultSeed);
+
+    // Bodies already spawned live out their own kill plane and lifetime
+    void set_spawners(const std::vector<SceneSpawner> &spawners);
+    void update(float delta_time);
+    // Despawns everything, for shutdown
+    void clear();
+
+    // The live spawned spheres, for rendering
+    [[nodiscard]] const std::vector<SceneSphere> &spheres() const;
+    // Most spheres the current spawners can have alive at once
+    [[nodiscard]] std::size_t capacity() const;
+    [[nodiscard]] const SpawnerStats &stats() const;
+
+private:
+    struct Spawned
+    {
+        float age;
+        float lifetime;
+        float kill_y;
+        std::size_t spawner;
+    };
+
+    void despawn(float delta_time);
+    void spawn(float delta_time);
+    void update_rates(float delta_time);
+
+    PhysicsEngine &_physics_engine;
+    std::mt19937 _generator;
+    std::vector<SceneSpawner> _spawners{};
+    std::vector<JPH::ShapeRefC> _shapes{};
+    std::vector<float> _due{};
+    std::vector<uint32_t> _alive{};
+    // Kept in step with each other, one entry per live body
+    std::vector<SceneSphere> _spheres{};
+    std::vector<Spawned> _spawned{};
+    // Scratch space reused every update
+    std::vector<JPH::BodyCreationSettings> _settings{};
+    std::vector<std::size_t> _settings_spawner{};
+    JPH::BodyIDVector _body_ids{};
+    SpawnerStats _stats{};
+    float _window_seconds{0.F};
+    uint64_t _window_spawned{0};
+    uint64_t _window_despawned{0};
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include "static_merge.h"
+
+#include "scene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+int64_t cell_of(const float position, const float cell_size)
+{
+    return static_cast<int64_t>(std::floor(position / cell_size));
+}
+
+auto cluster_key(const SceneBody &body, const float cell_size)
+{
+    return std::make_tuple(cell_of(body.position.x, cell_size),
+                           cell_of(body.position.y, cell_size),
+                           cell_of(body.position.z, cell_size),
+                           body.material.friction,
+                           body.material.restitution);
+}
+} // namespace
+
+namespace static_merge
+{
+void cluster(const std::vector<SceneBody> &bodies,
+             const float cell_size,
+             StaticClusters &clusters)
+{
+    std::vector<std::size_t> &members{clusters.members};
+    members.resize(bodies.size());
+    std::iota(members.begin(), members.end(), std::size_t{0});
+    std::stable_sort(members.begin(),
+                     members.end(),
+                     [&bodies, cell_size](const std::size_t lhs,
+                                          const std::size_t rhs)
+                     {
+                         return cluster_key(bodies[lhs], cell_size) <
+                                cluster_key(bodies[rhs], cell_size);
+                     });
+
+    clusters.clusters.clear();
+    for (std::size_t index{0}; index < members.size(); ++index)
+    {
+        if (index == 0 ||
+            cluster_key(bodies[members[index - 1]], cell_size) !=
+                cluster_key(bodies[members[index]], cell_size))
+        {
+            clusters.clusters.push_back(StaticCluster{index, 0});
+        }
+        ++clusters.clusters.back().count;
+    }
+}
+} // namespace static_merge
@@ -0,0 +1,34 @@
+#ifndef SRC_SCENE_STATIC_MERGE_H
+#define SRC_SCENE_STATIC_MERGE_H
+
+#include "scene.h"
+
+#include <cstddef>
+#include <vector>
+
+// A run of StaticClusters::members that becomes one body
+struct StaticCluster
+{
+    std::size_t first{0};
+    std::size_t count{0};
+};
+
+struct StaticClusters
+{
+    std::vector<std::size_t> members{}; // indices into the clustered bodies
+    std::vector<StaticCluster> clusters{};
+};
+
+namespace static_merge
+{
+// Groups bodies by the grid cell of size cell_size their centre falls in.
+// A body has a single friction and restitution, so bodies with different
+// materials never share a cluster. Clusters come out in cell order, members
+// in their original order, and a body alone in its cell is a cluster of one.
+// The vectors in clusters keep their capacity between calls.
+void cluster(const std::vector<SceneBody> &bodies,
+             float cell_size,
+             StaticClusters &clusters);
+} // namespace static_merge
+
+#endif
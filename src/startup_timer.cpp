@@ -0,0 +1,70 @@
+#include "startup_timer.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+void StartupTimer::record(const std::string &name,
+                          const Clock::time_point start,
+                          const Clock::time_point end)
+{
+    StartupPhase phase{name,
+                       offset_milliseconds(start),
+                       offset_milliseconds(end),
+                       std::this_thread::get_id() == _main_thread};
+    const std::lock_guard<std::mutex> lock{_mutex};
+    _phases.push_back(std::move(phase));
+}
+
+void StartupTimer::mark_first_frame(const Clock::time_point time)
+{
+    const std::lock_guard<std::mutex> lock{_mutex};
+    _first_frame_milliseconds = offset_milliseconds(time);
+}
+
+std::vector<StartupPhase> StartupTimer::phases() const
+{
+    std::vector<StartupPhase> phases{};
+    {
+        const std::lock_guard<std::mutex> lock{_mutex};
+        phases = _phases;
+    }
+    std::stable_sort(phases.begin(),
+                     phases.end(),
+                     [](const StartupPhase &lhs, const StartupPhase &rhs)
+                     { return lhs.start_milliseconds < rhs.start_milliseconds; });
+    return phases;
+}
+
+float StartupTimer::time_to_first_frame_milliseconds() const
+{
+    const std::lock_guard<std::mutex> lock{_mutex};
+    return _first_frame_milliseconds;
+}
+
+void StartupTimer::log() const
+{
+    for (const StartupPhase &phase : phases())
+    {
+        spdlog::info("Startup {:<24} {:>8.1f} ms, from {:>8.1f} to {:>8.1f} ms "
+                     "on the {} thread",
+                     phase.name,
+                     phase.end_milliseconds - phase.start_milliseconds,
+                     phase.start_milliseconds,
+                     phase.end_milliseconds,
+                     phase.main_thread ? "main" : "worker");
+    }
+    spdlog::info("Time to first frame: {:.1f} ms",
+                 time_to_first_frame_milliseconds());
+}
+
+float StartupTimer::offset_milliseconds(const Clock::time_point time) const
+{
+    return std::chrono::duration<float, std::milli>(time - _created).count();
+}
@@ -0,0 +1,67 @@
+#ifndef SRC_STARTUP_TIMER_H
+#define SRC_STARTUP_TIMER_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+struct StartupPhase
+{
+    std::string name{};
+    // Offsets from when the timer was created
+    float start_milliseconds{0.F};
+    float end_milliseconds{0.F};
+    bool main_thread{true};
+};
+
+// Records how long each startup phase takes and when it ran, so phases that
+// overlap on worker threads show up as overlapping. Phases can be recorded
+// from any thread.
+class StartupTimer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Runs function as a named phase and returns its result
+    template <typename Function>
+    auto time(const std::string &name, Function &&function)
+    {
+        const Clock::time_point start{Clock::now()};
+        if constexpr (std::is_void_v<decltype(function())>)
+        {
+            function();
+            record(name, start, Clock::now());
+        }
+        else
+        {
+            auto result{function()};
+            record(name, start, Clock::now());
+            return result;
+        }
+    }
+
+    void record(const std::string &name,
+                Clock::time_point start,
+                Clock::time_point end);
+    void mark_first_frame(Clock::time_point time);
+
+    // Phases in the order they started
+    [[nodiscard]] std::vector<StartupPhase> phases() const;
+    // Zero until mark_first_frame is called
+    [[nodiscard]] float time_to_first_frame_milliseconds() const;
+    void log() const;
+
+private:
+    [[nodiscard]] float offset_milliseconds(Clock::time_point time) const;
+
+    Clock::time_point _created{Clock::now()};
+    std::thread::id _main_thread{std::this_thread::get_id()};
+    mutable std::mutex _mutex{};
+    std::vector<StartupPhase> _phases{};
+    float _first_frame_milliseconds{0.F};
+};
+
+#endif
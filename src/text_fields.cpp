@@ -0,0 +1,112 @@
+#include "text_fields.h"
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+// strtof and strtoul need a terminated string, and a number never needs this
+// much room
+constexpr std::size_t kMaxNumberLength{63};
+using NumberBuffer = std::array<char, kMaxNumberLength + 1>;
+
+bool is_space(const char character)
+{
+    return character == ' ' || character == '\t' || character == '\r';
+}
+
+bool copy_terminated(const std::string_view token, NumberBuffer &buffer)
+{
+    if (token.empty() || token.size() > kMaxNumberLength)
+    {
+        return false;
+    }
+    std::memcpy(buffer.data(), token.data(), token.size());
+    buffer.at(token.size()) = '\0';
+    return true;
+}
+} // namespace
+
+namespace text_fields
+{
+void tokenise(std::string_view line, std::vector<std::string_view> &tokens)
+{
+    tokens.clear();
+    const std::size_t comment{line.find('#')};
+    if (comment != std::string_view::npos)
+    {
+        line = line.substr(0, comment);
+    }
+    std::size_t position{0};
+    while (position < line.size())
+    {
+        while (position < line.size() && is_space(line[position]))
+        {
+            ++position;
+        }
+        const std::size_t start{position};
+        while (position < line.size() && !is_space(line[position]))
+        {
+            ++position;
+        }
+        if (position > start)
+        {
+            tokens.push_back(line.substr(start, position - start));
+        }
+    }
+}
+
+bool parse_float(const std::string_view token, float &value)
+{
+    NumberBuffer buffer{};
+    if (!copy_terminated(token, buffer))
+    {
+        return false;
+    }
+    char *end{nullptr};
+    errno = 0;
+    value = std::strtof(buffer.data(), &end);
+    return errno == 0 && end == buffer.data() + token.size(); // NOLINT
+}
+
+bool parse_unsigned(const std::string_view token, uint32_t &value)
+{
+    NumberBuffer buffer{};
+    if (!copy_terminated(token, buffer) || token.front() == '-')
+    {
+        return false;
+    }
+    char *end{nullptr};
+    errno = 0;
+    constexpr int kBase{10};
+    const unsigned long number{std::strtoul(buffer.data(), &end, kBase)};
+    if (errno != 0 || end != buffer.data() + token.size() || // NOLINT
+        number > UINT32_MAX)
+    {
+        return false;
+    }
+    value = static_cast<uint32_t>(number);
+    return true;
+}
+
+bool parse_bool(const std::string_view token, bool &value)
+{
+    if (token == "true" || token == "on" || token == "1")
+    {
+        value = true;
+        return true;
+    }
+    if (token == "false" || token == "off" || token == "0")
+    {
+        value = false;
+        return true;
+    }
+    return false;
+}
+} // namespace text_fields
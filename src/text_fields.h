@@ -0,0 +1,22 @@
+#ifndef SRC_TEXT_FIELDS_H
+#define SRC_TEXT_FIELDS_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Helpers for the line based text files the game reads, such as scenes and
+// tuning. None of them allocate once tokens has reached its working size.
+namespace text_fields
+{
+// Splits a line into whitespace separated words, dropping anything after a #
+void tokenise(std::string_view line, std::vector<std::string_view> &tokens);
+
+// The whole token must be a number for these to succeed
+bool parse_float(std::string_view token, float &value);
+bool parse_unsigned(std::string_view token, uint32_t &value);
+// Accepts true/false, on/off and 1/0
+bool parse_bool(std::string_view token, bool &value);
+} // namespace text_fields
+
+#endif
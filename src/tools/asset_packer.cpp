@@ -0,0 +1,22 @@
+#include "assets/asset_archive.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cstdlib>
+#include <filesystem>
+
+// Packs a directory into an asset archive. Run by the build, which passes
+// the assets directory and the archive path next to the game executable.
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        spdlog::info("Usage: AssetPacker <directory> <archive>");
+        return EXIT_FAILURE;
+    }
+    const std::filesystem::path directory{
+        argv[1]}; // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+    const std::filesystem::path output{
+        argv[2]}; // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+    return pack_asset_archive(directory, output) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,160 @@
+#include "physics/flight_recorder_format.h"
+#include "platform/mapped_file.h"
+
+#include <fmt/core.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+
+namespace
+{
+void print_usage()
+{
+    spdlog::info("Usage: FlightRecorderDump <recording> [--output <csv>]");
+}
+
+bool valid_header(const flight_recorder::FileHeader &header,
+                  const std::size_t file_size)
+{
+    if (header.magic != flight_recorder::kMagic)
+    {
+        spdlog::error("Not a flight recorder file");
+        return false;
+    }
+    if (header.version != flight_recorder::kVersion ||
+        header.record_size != sizeof(flight_recorder::BodyRecord))
+    {
+        spdlog::error("Unsupported flight recorder version {}", header.version);
+        return false;
+    }
+    if (header.capacity == 0)
+    {
+        spdlog::error("Flight recorder file has no records");
+        return false;
+    }
+    // Divide rather than multiply, so a corrupt capacity cannot wrap around
+    if (header.capacity > (file_size - flight_recorder::kHeaderSize) /
+                              sizeof(flight_recorder::BodyRecord))
+    {
+        spdlog::error("Flight recorder file is truncated");
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+// Converts a flight recorder ring file to CSV, oldest record first, leaving
+// out any records from a step that was cut short. Writes to standard output
+// unless --output is given.
+int main(int argc, char **argv)
+{
+    std::filesystem::path input{};
+    std::filesystem::path output{};
+    for (int index{1}; index < argc; ++index)
+    {
+        const std::string_view argument{
+            argv[index]}; // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+        if (argument == "--output" && index + 1 < argc)
+        {
+            output =
+                argv[++index]; // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+        }
+        else if (input.empty())
+        {
+            input = argument;
+        }
+        else
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+    }
+    if (input.empty())
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    MappedFile file{};
+    if (!file.open_read_only(input) ||
+        file.size() < flight_recorder::kHeaderSize)
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Copy the header out rather than aliasing the mapping
+    flight_recorder::FileHeader header{};
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (!valid_header(header, file.size()))
+    {
+        return EXIT_FAILURE;
+    }
+
+    std::FILE *stream{stdout};
+    if (!output.empty())
+    {
+        stream = std::fopen(output.string().c_str(), "w");
+        if (stream == nullptr)
+        {
+            spdlog::error("Unable to write {}", output.string());
+            return EXIT_FAILURE;
+        }
+    }
+
+    fmt::print(stream,
+               "step,body_id,layer,motion_type,active,"
+               "position_x,position_y,position_z,"
+               "rotation_x,rotation_y,rotation_z,rotation_w,"
+               "linear_velocity_x,linear_velocity_y,linear_velocity_z,"
+               "angular_velocity_x,angular_velocity_y,angular_velocity_z\n");
+
+    const uint64_t count{std::min(header.write_index, header.capacity)};
+    const std::byte *records{file.data() + flight_recorder::kHeaderSize};
+    for (uint64_t index{header.write_index - count}; index < header.write_index;
+         ++index)
+    {
+        flight_recorder::BodyRecord record{};
+        std::memcpy(&record,
+                    records + (index % header.capacity) * sizeof(record),
+                    sizeof(record));
+        // Written by a step that never finished publishing
+        if (record.step > header.last_step)
+        {
+            continue;
+        }
+        fmt::print(stream,
+                   "{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{}\n",
+                   record.step,
+                   record.body_id,
+                   record.layer,
+                   record.motion_type,
+                   record.active,
+                   record.position[0],
+                   record.position[1],
+                   record.position[2],
+                   record.rotation[0],
+                   record.rotation[1],
+                   record.rotation[2],
+                   record.rotation[3],
+                   record.linear_velocity[0],
+                   record.linear_velocity[1],
+                   record.linear_velocity[2],
+                   record.angular_velocity[0],
+                   record.angular_velocity[1],
+                   record.angular_velocity[2]);
+    }
+
+    // The log goes to standard output too, so only report when writing a file
+    if (stream != stdout)
+    {
+        std::fclose(stream);
+        spdlog::info("Wrote {} records, last step {}", count, header.last_step);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+#include "platform/cpu_features.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifndef ISA_LAUNCHER_PROGRAM
+#error "ISA_LAUNCHER_PROGRAM must name the program to launch"
+#endif
+
+namespace
+{
+constexpr std::string_view kOverrideVariable{"JOLT_RAYLIB_ISA"};
+
+std::filesystem::path program_directory(const char *argv_0)
+{
+#ifdef __linux__
+    std::error_code error{};
+    const std::filesystem::path self{
+        std::filesystem::read_symlink("/proc/self/exe", error)};
+    if (!error)
+    {
+        return self.parent_path();
+    }
+#endif
+    return std::filesystem::absolute(argv_0).parent_path();
+}
+
+std::filesystem::path variant_path(const std::filesystem::path &directory,
+                                   const IsaLevel level)
+{
+    std::string name{ISA_LAUNCHER_PROGRAM};
+    name += '-';
+    name += isa_suffix(level);
+#ifdef _WIN32
+    name += ".exe";
+#endif
+    return directory / name;
+}
+
+void log_features(const CpuFeatures &features)
+{
+    spdlog::info("SSE4.1 {} SSE4.2 {} POPCNT {} AVX {} AVX2 {} FMA {} F16C {} "
+                 "LZCNT {} BMI1 {} AVX-512 F {} VL {} DQ {}",
+                 features.sse4_1,
+                 features.sse4_2,
+                 features.popcnt,
+                 features.avx,
+                 features.avx2,
+                 features.fma,
+                 features.f16c,
+                 features.lzcnt,
+                 features.bmi1,
+                 features.avx512f,
+                 features.avx512vl,
+                 features.avx512dq);
+    spdlog::info("Best instruction set level: {}",
+                 isa_name(best_isa_level(features)));
+}
+
+// The variant to run: the JOLT_RAYLIB_ISA environment variable if set,
+// otherwise the highest built level this CPU supports
+std::optional<std::filesystem::path>
+choose_variant(const std::filesystem::path &directory,
+               const CpuFeatures &features)
+{
+    const char *forced{std::getenv( // NOLINT [concurrency-mt-unsafe]
+        std::string{kOverrideVariable}.c_str())};
+    if (forced != nullptr)
+    {
+        const std::optional<IsaLevel> level{parse_isa_level(forced)};
+        if (!level)
+        {
+            spdlog::error("Unknown {} value {}", kOverrideVariable, forced);
+            return std::nullopt;
+        }
+        if (!supports(features, *level))
+        {
+            spdlog::error("This CPU cannot run {}", isa_name(*level));
+            return std::nullopt;
+        }
+        return variant_path(directory, *level);
+    }
+
+    for (auto level{static_cast<int>(best_isa_level(features))}; level >= 0;
+         --level)
+    {
+        const std::filesystem::path path{
+            variant_path(directory, static_cast<IsaLevel>(level))};
+        if (std::filesystem::exists(path))
+        {
+            return path;
+        }
+    }
+    spdlog::error("No {} variant built for this CPU", ISA_LAUNCHER_PROGRAM);
+    return std::nullopt;
+}
+} // namespace
+
+// Runs the variant of ISA_LAUNCHER_PROGRAM built for the best instruction set
+// this CPU supports, passing the arguments through. Jolt's SIMD code is
+// inlined through its headers into everything that uses it, so one executable
+// cannot hold several levels. Instead each level is a separate build, and
+// this launcher picks between them before any of that code runs.
+//
+// As the first argument, --isa-info logs the detected features and
+// --isa-supported <level> exits with success if this CPU can run the level.
+int main(int argc, char **argv)
+{
+    const CpuFeatures features{read_cpu_features()};
+    const std::vector<std::string_view> arguments(
+        argv, argv + argc); // NOLINT [cppcoreguidelines-pro-bounds-pointer-arithmetic]
+    if (arguments.size() == 2 && arguments.at(1) == "--isa-info")
+    {
+        log_features(features);
+        return EXIT_SUCCESS;
+    }
+    if (arguments.size() == 3 && arguments.at(1) == "--isa-supported")
+    {
+        const std::optional<IsaLevel> level{parse_isa_level(arguments.at(2))};
+        return level && supports(features, *level) ? EXIT_SUCCESS
+                                                   : EXIT_FAILURE;
+    }
+
+    const std::optional<std::filesystem::path> variant{
+        choose_variant(program_directory(arguments.at(0).data()), features)};
+    if (!variant)
+    {
+        return EXIT_FAILURE;
+    }
+    const std::string variant_string{variant->string()};
+    spdlog::debug("Launching {}", variant_string);
+
+    std::vector<char *> child_arguments(argv, argv + argc + 1); // NOLINT
+    child_arguments.front() = const_cast<char *>( // NOLINT
+        variant_string.c_str());
+#ifdef _WIN32
+    const intptr_t result{_spawnv(
+        _P_WAIT, variant_string.c_str(), child_arguments.data())};
+    if (result == -1)
+    {
+        spdlog::error("Unable to launch {}", variant_string);
+        return EXIT_FAILURE;
+    }
+    return static_cast<int>(result);
+#else
+    execv(variant_string.c_str(), child_arguments.data());
+    spdlog::error("Unable to launch {}", variant_string);
+    return EXIT_FAILURE;
+#endif
+}
@@ -0,0 +1,225 @@
+#include "tuning.h"
+
+#include "physics/vec3.h"
+#include "text_fields.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+bool same(const Vec3 &lhs, const Vec3 &rhs)
+{
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
+}
+
+// Reads the value after the name, checking nothing follows it
+class ValueReader
+{
+public:
+    explicit ValueReader(const std::vector<std::string_view> &tokens)
+        : _tokens{tokens}
+    {
+    }
+
+    [[nodiscard]] const char *error() const
+    {
+        return _error;
+    }
+
+    bool read(float &value)
+    {
+        if (expect(1) && !text_fields::parse_float(_tokens[1], value))
+        {
+            _error = "expected a number";
+        }
+        return _error == nullptr;
+    }
+
+    bool read_positive(float &value)
+    {
+        if (read(value) && value <= 0.F)
+        {
+            _error = "must be positive";
+        }
+        return _error == nullptr;
+    }
+
+    bool read_positive(uint32_t &value)
+    {
+        if (expect(1) && !text_fields::parse_unsigned(_tokens[1], value))
+        {
+            _error = "expected a whole number";
+        }
+        else if (_error == nullptr && value == 0)
+        {
+            _error = "must be positive";
+        }
+        return _error == nullptr;
+    }
+
+    bool read(bool &value)
+    {
+        if (expect(1) && !text_fields::parse_bool(_tokens[1], value))
+        {
+            _error = "expected true or false";
+        }
+        return _error == nullptr;
+    }
+
+    bool read(Vec3 &value)
+    {
+        if (expect(3) && (!text_fields::parse_float(_tokens[1], value.x) ||
+                          !text_fields::parse_float(_tokens[2], value.y) ||
+                          !text_fields::parse_float(_tokens[3], value.z)))
+        {
+            _error = "expected three numbers";
+        }
+        return _error == nullptr;
+    }
+
+private:
+    bool expect(const std::size_t count)
+    {
+        if (_tokens.size() != count + 1)
+        {
+            _error = count == 1 ? "expected one value" : "expected three values";
+        }
+        return _error == nullptr;
+    }
+
+    const std::vector<std::string_view> &_tokens;
+    const char *_error{nullptr};
+};
+
+const char *parse_line(const std::vector<std::string_view> &tokens,
+                       Tuning &tuning)
+{
+    ValueReader reader{tokens};
+    PhysicsTuning &physics{tuning.physics};
+    const std::string_view name{tokens.front()};
+    if (name == "tickrate")
+    {
+        reader.read_positive(tuning.tickrate);
+    }
+    else if (name == "kick_speed")
+    {
+        reader.read(tuning.kick_speed);
+    }
+    else if (name == "camera_position")
+    {
+        reader.read(tuning.camera_position);
+    }
+    else if (name == "camera_target")
+    {
+        reader.read(tuning.camera_target);
+    }
+    else if (name == "camera_fovy")
+    {
+        reader.read_positive(tuning.camera_fovy);
+    }
+    else if (name == "gravity")
+    {
+        reader.read(physics.gravity);
+    }
+    else if (name == "velocity_steps")
+    {
+        reader.read_positive(physics.velocity_steps);
+    }
+    else if (name == "position_steps")
+    {
+        reader.read_positive(physics.position_steps);
+    }
+    else if (name == "baumgarte")
+    {
+        reader.read(physics.baumgarte);
+    }
+    else if (name == "speculative_contact_distance")
+    {
+        reader.read(physics.speculative_contact_distance);
+    }
+    else if (name == "penetration_slop")
+    {
+        reader.read(physics.penetration_slop);
+    }
+    else if (name == "allow_sleeping")
+    {
+        reader.read(physics.allow_sleeping);
+    }
+    else
+    {
+        return "unknown setting";
+    }
+    return reader.error();
+}
+} // namespace
+
+bool operator==(const PhysicsTuning &lhs, const PhysicsTuning &rhs)
+{
+    return same(lhs.gravity, rhs.gravity) &&
+           lhs.velocity_steps == rhs.velocity_steps &&
+           lhs.position_steps == rhs.position_steps &&
+           lhs.baumgarte == rhs.baumgarte &&
+           lhs.speculative_contact_distance ==
+               rhs.speculative_contact_distance &&
+           lhs.penetration_slop == rhs.penetration_slop &&
+           lhs.allow_sleeping == rhs.allow_sleeping;
+}
+
+bool operator!=(const PhysicsTuning &lhs, const PhysicsTuning &rhs)
+{
+    return !(lhs == rhs);
+}
+
+namespace tuning_file
+{
+bool parse(std::istream &stream,
+           const std::string_view source_name,
+           Tuning &tuning)
+{
+    Tuning parsed{};
+    std::vector<std::string_view> tokens{};
+    std::string line{};
+    std::size_t line_number{0};
+    while (std::getline(stream, line))
+    {
+        ++line_number;
+        text_fields::tokenise(line, tokens);
+        if (tokens.empty())
+        {
+            continue;
+        }
+        const char *error{parse_line(tokens, parsed)};
+        if (error != nullptr)
+        {
+            spdlog::error("{}:{}: {}: {}",
+                          source_name,
+                          line_number,
+                          tokens.front(),
+                          error);
+            return false;
+        }
+    }
+    tuning = parsed;
+    return true;
+}
+
+bool parse_file(const std::filesystem::path &path, Tuning &tuning)
+{
+    std::ifstream stream{path};
+    if (!stream)
+    {
+        spdlog::error("Unable to read tuning {}", path.string());
+        return false;
+    }
+    return parse(stream, path.string(), tuning);
+}
+} // namespace tuning_file
@@ -0,0 +1,54 @@
+#ifndef SRC_TUNING_H
+#define SRC_TUNING_H
+
+#include "constants.h"
+#include "physics/vec3.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <string_view>
+
+// Solver values, defaulting to JPH::PhysicsSettings' own defaults
+struct PhysicsTuning
+{
+    Vec3 gravity{0.F, -9.81F, 0.F};
+    uint32_t velocity_steps{10};
+    uint32_t position_steps{2};
+    float baumgarte{0.2F};
+    float speculative_contact_distance{0.02F};
+    float penetration_slop{0.02F};
+    bool allow_sleeping{true};
+};
+
+// Values that used to need a rebuild to change. They are read from a tuning
+// file at startup and again whenever it is saved. Values the file leaves out
+// take these defaults.
+struct Tuning
+{
+    uint32_t tickrate{constants::kTickrate};
+    float kick_speed{5.F};
+    Vec3 camera_position{constants::kCameraPositionX,
+                         constants::kCameraPositionY,
+                         constants::kCameraPositionZ};
+    Vec3 camera_target{0.F, 0.F, 0.F};
+    float camera_fovy{constants::kCameraFovY};
+    PhysicsTuning physics{};
+};
+
+[[nodiscard]] bool operator==(const PhysicsTuning &lhs,
+                              const PhysicsTuning &rhs);
+[[nodiscard]] bool operator!=(const PhysicsTuning &lhs,
+                              const PhysicsTuning &rhs);
+
+// Tuning files hold one "<name> <value>" per line, vectors as three numbers,
+// with # comments. See config/tuning.cfg for every name.
+namespace tuning_file
+{
+// Leaves tuning untouched unless the whole file parses. Errors are logged
+// with their line number.
+bool parse(std::istream &stream, std::string_view source_name, Tuning &tuning);
+bool parse_file(const std::filesystem::path &path, Tuning &tuning);
+} // namespace tuning_file
+
+#endif